@@ -19,9 +19,14 @@
 
 #include <dataframe/array/bind.hpp>
 #include <dataframe/array/cast.hpp>
+#include <dataframe/array/logical.hpp>
 #include <dataframe/array/make.hpp>
+#include <dataframe/array/memory.hpp>
+#include <dataframe/array/promote.hpp>
 #include <dataframe/array/repeat.hpp>
+#include <dataframe/array/runs.hpp>
 #include <dataframe/array/split.hpp>
+#include <dataframe/array/stats.hpp>
 #include <dataframe/array/type.hpp>
 #include <dataframe/array/view.hpp>
 
@@ -19,37 +19,487 @@
 
 #include <dataframe/array/type.hpp>
 #include <arrow/array/concatenate.h>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
 
 namespace dataframe {
 
-inline std::shared_ptr<::arrow::Array> bind_array(
-    const ::arrow::ArrayVector &chunks)
+namespace internal {
+
+inline ::arrow::Status bind_bitmap(const ::arrow::ArrayVector &chunks,
+    std::int64_t length, std::size_t index, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Buffer> *out)
+{
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(
+        pool, ::arrow::BitUtil::BytesForBits(length), out));
+
+    auto bits = (*out)->mutable_data();
+    std::int64_t pos = 0;
+    for (auto &&chunk : chunks) {
+        auto &data = *chunk->data();
+        auto &buf = data.buffers.at(index);
+        if (buf == nullptr) {
+            ::arrow::BitUtil::SetBitsTo(bits, pos, data.length, true);
+        } else {
+            ::arrow::internal::CopyBitmap(
+                buf->data(), data.offset, data.length, bits, pos, true);
+        }
+        pos += data.length;
+    }
+
+    return ::arrow::Status::OK();
+}
+
+inline ::arrow::Status bind_fixed_width(const ::arrow::ArrayVector &chunks,
+    std::int64_t length, std::int64_t byte_width, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Buffer> *out)
+{
+    ARROW_RETURN_NOT_OK(
+        ::arrow::AllocateBuffer(pool, length * byte_width, out));
+
+    auto dst = (*out)->mutable_data();
+    for (auto &&chunk : chunks) {
+        auto &data = *chunk->data();
+        if (data.length == 0) {
+            continue;
+        }
+
+        auto nbytes = static_cast<std::size_t>(data.length * byte_width);
+        std::memcpy(
+            dst, data.buffers[1]->data() + data.offset * byte_width, nbytes);
+        dst += nbytes;
+    }
+
+    return ::arrow::Status::OK();
+}
+
+inline ::arrow::Status bind_binary(const ::arrow::ArrayVector &chunks,
+    std::int64_t length, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Buffer> *offsets_out,
+    std::shared_ptr<::arrow::Buffer> *values_out)
+{
+    std::int64_t nbytes = 0;
+    for (auto &&chunk : chunks) {
+        auto &array = static_cast<const ::arrow::BinaryArray &>(*chunk);
+        auto n = array.length();
+        if (n != 0) {
+            nbytes += array.value_offset(n) - array.value_offset(0);
+        }
+    }
+
+    if (nbytes > std::numeric_limits<std::int32_t>::max()) {
+        return ::arrow::Status::CapacityError(
+            "Binary data too large for 32-bit offsets");
+    }
+
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(pool,
+        (length + 1) * static_cast<std::int64_t>(sizeof(std::int32_t)),
+        offsets_out));
+
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(pool, nbytes, values_out));
+
+    auto offsets =
+        reinterpret_cast<std::int32_t *>((*offsets_out)->mutable_data());
+    auto values = (*values_out)->mutable_data();
+
+    std::int32_t pos = 0;
+    offsets[0] = 0;
+    for (auto &&chunk : chunks) {
+        auto &array = static_cast<const ::arrow::BinaryArray &>(*chunk);
+        auto n = array.length();
+        if (n == 0) {
+            continue;
+        }
+
+        auto src = array.raw_value_offsets();
+        auto base = src[0];
+        for (std::int64_t i = 0; i != n; ++i) {
+            offsets[i + 1] = pos + (src[i + 1] - base);
+        }
+
+        // All empty or all null chunks may have no values buffer
+        auto len = src[n] - base;
+        auto data = array.value_data();
+        if (len != 0 && data != nullptr) {
+            std::memcpy(
+                values, data->data() + base, static_cast<std::size_t>(len));
+        }
+
+        offsets += n;
+        values += len;
+        pos += len;
+    }
+
+    return ::arrow::Status::OK();
+}
+
+inline ::arrow::Status bind_array(const ::arrow::ArrayVector &chunks,
+    ::arrow::MemoryPool *pool, std::shared_ptr<::arrow::Array> *out);
+
+inline std::string_view dictionary_key(
+    const ::arrow::Array &values, std::int64_t i)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (values.type_id()) {
+        case ::arrow::Type::STRING:
+        case ::arrow::Type::BINARY: {
+            std::int32_t len = 0;
+            auto ptr = static_cast<const ::arrow::BinaryArray &>(values)
+                           .GetValue(i, &len);
+            return std::string_view(reinterpret_cast<const char *>(ptr),
+                static_cast<std::size_t>(len));
+        }
+        default: {
+            auto &data = *values.data();
+            auto width = static_cast<const ::arrow::FixedWidthType &>(
+                *values.type())
+                             .bit_width() /
+                8;
+            auto ptr = data.buffers[1]->data() + (data.offset + i) * width;
+            return std::string_view(reinterpret_cast<const char *>(ptr),
+                static_cast<std::size_t>(width));
+        }
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+inline ::arrow::Status make_dictionary_values(
+    const std::shared_ptr<::arrow::DataType> &type,
+    const std::vector<std::string_view> &keys, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Array> *out)
+{
+    auto n = static_cast<std::int64_t>(keys.size());
+    std::vector<std::shared_ptr<::arrow::Buffer>> buffers(1);
+
+    if (type->id() == ::arrow::Type::STRING ||
+        type->id() == ::arrow::Type::BINARY) {
+        std::int64_t nbytes = 0;
+        for (auto &&key : keys) {
+            nbytes += static_cast<std::int64_t>(key.size());
+        }
+
+        buffers.resize(3);
+        ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(pool,
+            (n + 1) * static_cast<std::int64_t>(sizeof(std::int32_t)),
+            &buffers[1]));
+        ARROW_RETURN_NOT_OK(
+            ::arrow::AllocateBuffer(pool, nbytes, &buffers[2]));
+
+        auto offsets =
+            reinterpret_cast<std::int32_t *>(buffers[1]->mutable_data());
+        auto values = buffers[2]->mutable_data();
+
+        offsets[0] = 0;
+        for (std::int64_t i = 0; i != n; ++i) {
+            auto &key = keys[static_cast<std::size_t>(i)];
+            std::memcpy(values + offsets[i], key.data(), key.size());
+            offsets[i + 1] =
+                offsets[i] + static_cast<std::int32_t>(key.size());
+        }
+    } else {
+        auto width = static_cast<const ::arrow::FixedWidthType &>(*type)
+                         .bit_width() /
+            8;
+
+        buffers.resize(2);
+        ARROW_RETURN_NOT_OK(
+            ::arrow::AllocateBuffer(pool, n * width, &buffers[1]));
+
+        auto values = buffers[1]->mutable_data();
+        for (auto &&key : keys) {
+            std::memcpy(values, key.data(), key.size());
+            values += key.size();
+        }
+    }
+
+    *out = ::arrow::MakeArray(
+        ::arrow::ArrayData::Make(type, n, std::move(buffers), 0));
+
+    return ::arrow::Status::OK();
+}
+
+template <typename Out>
+inline ::arrow::Status remap_dictionary_indices(
+    const ::arrow::ArrayVector &chunks,
+    const std::vector<std::vector<std::int32_t>> &transpose,
+    std::int64_t length, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Buffer> *out)
+{
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(
+        pool, length * static_cast<std::int64_t>(sizeof(Out)), out));
+
+    auto dst = reinterpret_cast<Out *>((*out)->mutable_data());
+    for (std::size_t k = 0; k != chunks.size(); ++k) {
+        auto indices =
+            static_cast<const ::arrow::DictionaryArray &>(*chunks[k])
+                .indices();
+        auto &map = transpose[k];
+        auto n = indices->length();
+
+        auto remap = [&](auto v) {
+            for (std::int64_t i = 0; i != n; ++i) {
+                if (indices->null_count() != 0 && indices->IsNull(i)) {
+                    dst[i] = 0;
+                } else if (map.empty()) {
+                    dst[i] = static_cast<Out>(v[i]);
+                } else {
+                    dst[i] = static_cast<Out>(
+                        map[static_cast<std::size_t>(v[i])]);
+                }
+            }
+        };
+
+        DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+        switch (indices->type_id()) {
+            case ::arrow::Type::INT8:
+                remap(static_cast<const ::arrow::Int8Array &>(*indices)
+                          .raw_values());
+                break;
+            case ::arrow::Type::INT16:
+                remap(static_cast<const ::arrow::Int16Array &>(*indices)
+                          .raw_values());
+                break;
+            case ::arrow::Type::INT32:
+                remap(static_cast<const ::arrow::Int32Array &>(*indices)
+                          .raw_values());
+                break;
+            case ::arrow::Type::INT64:
+                remap(static_cast<const ::arrow::Int64Array &>(*indices)
+                          .raw_values());
+                break;
+            default:
+                return ::arrow::Status::TypeError(
+                    "Unexpected dictionary index type");
+        }
+        DF_DIAGNOSTIC_POP
+
+        dst += n;
+    }
+
+    return ::arrow::Status::OK();
+}
+
+/// \brief Concatenate dictionary arrays, unifying their dictionaries
+///
+/// Distinct dictionaries are merged by value and the indices of each chunk
+/// are remapped into the unified dictionary without decoding the values
+inline ::arrow::Status bind_dictionary(const ::arrow::ArrayVector &chunks,
+    std::int64_t length, std::int64_t null_count, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Array> *out)
+{
+    auto &type =
+        static_cast<const ::arrow::DictionaryType &>(*chunks.front()->type());
+
+    ::arrow::ArrayVector dicts;
+    bool same = true;
+    for (auto &&chunk : chunks) {
+        dicts.push_back(
+            static_cast<const ::arrow::DictionaryArray &>(*chunk)
+                .dictionary());
+        same = same &&
+            (dicts.back() == dicts.front() ||
+                dicts.back()->Equals(dicts.front()));
+    }
+
+    std::shared_ptr<::arrow::Array> dictionary;
+    std::vector<std::vector<std::int32_t>> transpose(chunks.size());
+
+    if (same) {
+        dictionary = dicts.front();
+    } else {
+        auto value_id = type.value_type()->id();
+        if (value_id == ::arrow::Type::BOOL ||
+            (value_id != ::arrow::Type::STRING &&
+                value_id != ::arrow::Type::BINARY &&
+                dynamic_cast<const ::arrow::FixedWidthType *>(
+                    type.value_type().get()) == nullptr)) {
+            return ::arrow::Status::NotImplemented(
+                "Cannot unify dictionaries of type ",
+                type.value_type()->ToString());
+        }
+
+        std::shared_ptr<::arrow::Array> values;
+        ARROW_RETURN_NOT_OK(bind_array(dicts, pool, &values));
+
+        std::unordered_map<std::string_view, std::int32_t> memo;
+        std::vector<std::string_view> unique;
+        std::int64_t pos = 0;
+        for (std::size_t k = 0; k != dicts.size(); ++k) {
+            auto n = dicts[k]->length();
+            auto &map = transpose[k];
+            map.reserve(static_cast<std::size_t>(n));
+            for (std::int64_t i = 0; i != n; ++i, ++pos) {
+                auto key = dictionary_key(*values, pos);
+                auto iter = memo.emplace(
+                    key, static_cast<std::int32_t>(unique.size()));
+                if (iter.second) {
+                    unique.push_back(key);
+                }
+                map.push_back(iter.first->second);
+            }
+        }
+
+        ARROW_RETURN_NOT_OK(make_dictionary_values(
+            type.value_type(), unique, pool, &dictionary));
+    }
+
+    auto index_type = type.index_type();
+    auto max_index = dictionary->length() - 1;
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (index_type->id()) {
+        case ::arrow::Type::INT8:
+            if (max_index > std::numeric_limits<std::int8_t>::max()) {
+                index_type = ::arrow::int32();
+            }
+            break;
+        case ::arrow::Type::INT16:
+            if (max_index > std::numeric_limits<std::int16_t>::max()) {
+                index_type = ::arrow::int32();
+            }
+            break;
+        default:
+            break;
+    }
+    DF_DIAGNOSTIC_POP
+
+    std::vector<std::shared_ptr<::arrow::Buffer>> buffers(2);
+
+    if (index_type->id() == ::arrow::Type::INT8) {
+        ARROW_RETURN_NOT_OK(remap_dictionary_indices<std::int8_t>(
+            chunks, transpose, length, pool, &buffers[1]));
+    } else if (index_type->id() == ::arrow::Type::INT16) {
+        ARROW_RETURN_NOT_OK(remap_dictionary_indices<std::int16_t>(
+            chunks, transpose, length, pool, &buffers[1]));
+    } else if (index_type->id() == ::arrow::Type::INT32) {
+        ARROW_RETURN_NOT_OK(remap_dictionary_indices<std::int32_t>(
+            chunks, transpose, length, pool, &buffers[1]));
+    } else {
+        ARROW_RETURN_NOT_OK(remap_dictionary_indices<std::int64_t>(
+            chunks, transpose, length, pool, &buffers[1]));
+    }
+
+    if (null_count != 0) {
+        ARROW_RETURN_NOT_OK(
+            bind_bitmap(chunks, length, 0, pool, &buffers[0]));
+    }
+
+    auto indices = ::arrow::MakeArray(::arrow::ArrayData::Make(
+        index_type, length, std::move(buffers), null_count));
+
+    return ::arrow::DictionaryArray::FromArrays(
+        ::arrow::dictionary(index_type, type.value_type(), type.ordered()),
+        indices, dictionary, out);
+}
+
+/// \brief Concatenate arrays of identical type
+///
+/// Fixed-width and binary arrays are bound with each output buffer allocated
+/// exactly once from the total length. Dictionary arrays are unified. Other
+/// types fall back to `::arrow::Concatenate`
+inline ::arrow::Status bind_array(const ::arrow::ArrayVector &chunks,
+    ::arrow::MemoryPool *pool, std::shared_ptr<::arrow::Array> *out)
 {
     if (chunks.empty()) {
-        return nullptr;
+        *out = nullptr;
+        return ::arrow::Status::OK();
     }
 
     if (chunks.size() == 1) {
-        return chunks.front();
+        *out = chunks.front();
+        return ::arrow::Status::OK();
+    }
+
+    auto type = chunks.front()->type();
+
+    std::int64_t length = 0;
+    std::int64_t null_count = 0;
+    for (auto &&chunk : chunks) {
+        if (!chunk->type()->Equals(*type)) {
+            return ::arrow::Status::Invalid("Cannot bind arrays of type ",
+                type->ToString(), " and ", chunk->type()->ToString());
+        }
+        length += chunk->length();
+        null_count += chunk->null_count();
+    }
+
+    std::vector<std::shared_ptr<::arrow::Buffer>> buffers(2);
+
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type->id()) {
+        case ::arrow::Type::BOOL:
+            ARROW_RETURN_NOT_OK(
+                bind_bitmap(chunks, length, 1, pool, &buffers[1]));
+            break;
+        case ::arrow::Type::UINT8:
+        case ::arrow::Type::INT8:
+        case ::arrow::Type::UINT16:
+        case ::arrow::Type::INT16:
+        case ::arrow::Type::UINT32:
+        case ::arrow::Type::INT32:
+        case ::arrow::Type::UINT64:
+        case ::arrow::Type::INT64:
+        case ::arrow::Type::HALF_FLOAT:
+        case ::arrow::Type::FLOAT:
+        case ::arrow::Type::DOUBLE:
+        case ::arrow::Type::DATE32:
+        case ::arrow::Type::DATE64:
+        case ::arrow::Type::TIMESTAMP:
+        case ::arrow::Type::TIME32:
+        case ::arrow::Type::TIME64:
+        case ::arrow::Type::FIXED_SIZE_BINARY:
+        case ::arrow::Type::DECIMAL: {
+            auto &fixed = static_cast<const ::arrow::FixedWidthType &>(*type);
+            ARROW_RETURN_NOT_OK(bind_fixed_width(
+                chunks, length, fixed.bit_width() / 8, pool, &buffers[1]));
+        } break;
+        case ::arrow::Type::STRING:
+        case ::arrow::Type::BINARY:
+            buffers.resize(3);
+            ARROW_RETURN_NOT_OK(
+                bind_binary(chunks, length, pool, &buffers[1], &buffers[2]));
+            break;
+        case ::arrow::Type::DICTIONARY:
+            return bind_dictionary(chunks, length, null_count, pool, out);
+        default:
+            return ::arrow::Concatenate(chunks, pool, out);
+    }
+    DF_DIAGNOSTIC_POP
+
+    if (null_count != 0) {
+        ARROW_RETURN_NOT_OK(
+            bind_bitmap(chunks, length, 0, pool, &buffers[0]));
     }
 
+    *out = ::arrow::MakeArray(::arrow::ArrayData::Make(
+        type, length, std::move(buffers), null_count));
+
+    return ::arrow::Status::OK();
+}
+
+} // namespace internal
+
+inline std::shared_ptr<::arrow::Array> bind_array(
+    const ::arrow::ArrayVector &chunks,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
     std::shared_ptr<::arrow::Array> ret;
-    DF_ARROW_ERROR_HANDLER(
-        ::arrow::Concatenate(chunks, ::arrow::default_memory_pool(), &ret));
+    DF_ARROW_ERROR_HANDLER(internal::bind_array(chunks, pool, &ret));
 
     return ret;
 }
 
 template <typename InputIter>
-inline std::shared_ptr<::arrow::Array> bind_array(
-    InputIter first, InputIter last)
+inline std::shared_ptr<::arrow::Array> bind_array(InputIter first,
+    InputIter last,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
     ::arrow::ArrayVector chunks;
     for (auto iter = first; iter != last; ++iter) {
         chunks.emplace_back(*iter);
     }
 
-    return bind_array(chunks);
+    return bind_array(chunks, pool);
 }
 
 } // namespace dataframe
@@ -18,11 +18,13 @@
 #define DATAFRAME_ARRAY_CAST_HPP
 
 #include <dataframe/array/cast/bool.hpp>
+#include <dataframe/array/cast/cache.hpp>
 #include <dataframe/array/cast/datetime.hpp>
 #include <dataframe/array/cast/dict.hpp>
 #include <dataframe/array/cast/list.hpp>
 #include <dataframe/array/cast/null.hpp>
 #include <dataframe/array/cast/opaque.hpp>
+#include <dataframe/array/cast/parse.hpp>
 #include <dataframe/array/cast/primitive.hpp>
 #include <dataframe/array/cast/string.hpp>
 #include <dataframe/array/cast/struct.hpp>
@@ -0,0 +1,191 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_CAST_CACHE_HPP
+#define DATAFRAME_ARRAY_CAST_CACHE_HPP
+
+#include <dataframe/array/cast/primitive.hpp>
+#include <list>
+#include <map>
+#include <mutex>
+#include <typeindex>
+
+namespace dataframe {
+
+namespace internal {
+
+/// \brief Process wide cache of the most recent cast results, keyed on the
+/// identity of the source data and the destination type
+///
+/// The cache only holds weak references to the sources, entries of released
+/// data are dropped on the next lookup or insertion, and the least recently
+/// used entry is evicted once the capacity is reached. Results must not own
+/// their source, otherwise it would never be released, so casts that return
+/// the source array are not cached
+class CastCache
+{
+  public:
+    static CastCache &instance()
+    {
+        static CastCache cache;
+
+        return cache;
+    }
+
+    std::shared_ptr<::arrow::Array> find(
+        const std::shared_ptr<const void> &key, std::type_index type)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        prune();
+
+        auto iter = index_.find(Key{key, type});
+        if (iter == index_.end()) {
+            return nullptr;
+        }
+
+        entries_.splice(entries_.begin(), entries_, iter->second);
+
+        return iter->second->value;
+    }
+
+    void insert(const std::shared_ptr<const void> &key, std::type_index type,
+        std::shared_ptr<::arrow::Array> value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        prune();
+
+        Key k{key, type};
+        auto iter = index_.find(k);
+        if (iter != index_.end()) {
+            remove(iter->second);
+        }
+
+        while (!entries_.empty() && entries_.size() >= capacity_) {
+            remove(std::prev(entries_.end()));
+        }
+
+        if (capacity_ == 0) {
+            return;
+        }
+
+        entries_.push_front(Entry{k, std::move(value)});
+        index_.emplace(std::move(k), entries_.begin());
+    }
+
+    /// \brief Drop the cast results of a source for all destination types
+    void erase(const std::shared_ptr<const void> &key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::owner_less<std::shared_ptr<const void>> less;
+        for (auto iter = entries_.begin(); iter != entries_.end();) {
+            auto &source = iter->key.source;
+            auto same = !less(key, source) && !less(source, key);
+            iter = same ? remove(iter) : std::next(iter);
+        }
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        index_.clear();
+        entries_.clear();
+    }
+
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return entries_.size();
+    }
+
+    std::size_t capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return capacity_;
+    }
+
+    /// \brief Set the maximum number of cached results, zero disables the
+    /// cache
+    void set_capacity(std::size_t n)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        capacity_ = n;
+        while (entries_.size() > capacity_) {
+            remove(std::prev(entries_.end()));
+        }
+    }
+
+  private:
+    struct Key {
+        std::weak_ptr<const void> source;
+        std::type_index type;
+    };
+
+    struct KeyLess {
+        bool operator()(const Key &k1, const Key &k2) const
+        {
+            if (k1.source.owner_before(k2.source)) {
+                return true;
+            }
+
+            if (k2.source.owner_before(k1.source)) {
+                return false;
+            }
+
+            return k1.type < k2.type;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<::arrow::Array> value;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    CastCache() = default;
+
+    EntryList::iterator remove(EntryList::iterator iter)
+    {
+        index_.erase(iter->key);
+
+        return entries_.erase(iter);
+    }
+
+    void prune()
+    {
+        for (auto iter = entries_.begin(); iter != entries_.end();) {
+            iter = iter->key.source.expired() ? remove(iter) : std::next(iter);
+        }
+    }
+
+    mutable std::mutex mutex_;
+    EntryList entries_;
+    std::map<Key, EntryList::iterator, KeyLess> index_;
+    std::size_t capacity_ = 64;
+};
+
+} // namespace internal
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_CAST_CACHE_HPP
@@ -36,6 +36,8 @@ template <typename T, typename Array>
         auto data = array.data()->Copy();
         data->type = make_data_type<T>();
         result = ::arrow::MakeArray(data);
+
+        return ::arrow::Status::OK();
     }
 
     auto n = array.length();
@@ -68,11 +70,7 @@ template <typename T, typename Array>
     data.buffers.emplace_back(nullptr);
     data.buffers.emplace_back(std::move(value_buffer));
 
-    if (data.null_count != 0) {
-        ARROW_RETURN_NOT_OK(
-            ::arrow::internal::CopyBitmap(pool, array.null_bitmap()->data(),
-                array.offset(), array.length(), &data.buffers[0]));
-    }
+    ARROW_RETURN_NOT_OK(share_null_bitmap(array, pool, &data.buffers[0]));
 
     result = ::arrow::MakeArray(
         std::make_shared<::arrow::ArrayData>(std::move(data)));
@@ -86,12 +84,20 @@ template <DateUnit Unit>
 struct CastArrayVisitor<Datestamp<Unit>> : ::arrow::ArrayVisitor {
     std::shared_ptr<::arrow::Array> result;
     ::arrow::MemoryPool *pool;
+    CastPolicy policy;
 
-    CastArrayVisitor(
-        std::shared_ptr<::arrow::Array> data, ::arrow::MemoryPool *p)
+    CastArrayVisitor(std::shared_ptr<::arrow::Array> data,
+        ::arrow::MemoryPool *p, CastPolicy c = CastPolicy::Unchecked)
         : result(std::move(data))
         , pool(p)
+        , policy(c)
+    {
+    }
+
+    ::arrow::Status Visit(const ::arrow::StringArray &array) override
     {
+        return internal::parse_array<Datestamp<Unit>>(
+            array, policy, pool, &result);
     }
 
     ::arrow::Status Visit(const ::arrow::Date32Array &array) override
@@ -114,14 +120,22 @@ template <TimeUnit Unit>
 struct CastArrayVisitor<Timestamp<Unit>> : ::arrow::ArrayVisitor {
     std::shared_ptr<::arrow::Array> result;
     ::arrow::MemoryPool *pool;
+    CastPolicy policy;
 
-    CastArrayVisitor(
-        std::shared_ptr<::arrow::Array> data, ::arrow::MemoryPool *p)
+    CastArrayVisitor(std::shared_ptr<::arrow::Array> data,
+        ::arrow::MemoryPool *p, CastPolicy c = CastPolicy::Unchecked)
         : result(std::move(data))
         , pool(p)
+        , policy(c)
     {
     }
 
+    ::arrow::Status Visit(const ::arrow::StringArray &array) override
+    {
+        return internal::parse_array<Timestamp<Unit>>(
+            array, policy, pool, &result);
+    }
+
     ::arrow::Status Visit(const ::arrow::Date32Array &array) override
     {
         return internal::cast_time_array<Timestamp<Unit>>(array, result, pool);
@@ -142,12 +156,19 @@ template <TimeUnit Unit>
 struct CastArrayVisitor<Time<Unit>> : ::arrow::ArrayVisitor {
     std::shared_ptr<::arrow::Array> result;
     ::arrow::MemoryPool *pool;
+    CastPolicy policy;
 
-    CastArrayVisitor(
-        std::shared_ptr<::arrow::Array> data, ::arrow::MemoryPool *p)
+    CastArrayVisitor(std::shared_ptr<::arrow::Array> data,
+        ::arrow::MemoryPool *p, CastPolicy c = CastPolicy::Unchecked)
         : result(std::move(data))
         , pool(p)
+        , policy(c)
+    {
+    }
+
+    ::arrow::Status Visit(const ::arrow::StringArray &array) override
     {
+        return internal::parse_array<Time<Unit>>(array, policy, pool, &result);
     }
 
     ::arrow::Status Visit(const ::arrow::Time32Array &array) override
@@ -0,0 +1,431 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_CAST_PARSE_HPP
+#define DATAFRAME_ARRAY_CAST_PARSE_HPP
+
+#include <dataframe/array/type.hpp>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <system_error>
+
+namespace dataframe {
+
+namespace internal {
+
+/// \brief Parse a decimal number that spans exactly `[first, last)`
+///
+/// A leading `+` is accepted. A well formed number out of the range of `T`
+/// is clamped to the nearest bound if `saturate` is set, and is an error of
+/// `result_out_of_range` otherwise. A floating point number too small to be
+/// represented is clamped to zero
+template <typename T>
+inline std::errc parse_number(
+    const char *first, const char *last, bool saturate, T &out)
+{
+    if (first != last && *first == '+') {
+        ++first;
+        if (first != last && *first == '-') {
+            return std::errc::invalid_argument;
+        }
+    }
+
+    if (first == last) {
+        return std::errc::invalid_argument;
+    }
+
+#if defined(__cpp_lib_to_chars)
+    constexpr bool use_from_chars = true;
+#else
+    constexpr bool use_from_chars = std::is_integral_v<T>;
+#endif
+
+    if constexpr (use_from_chars) {
+        auto ret = std::from_chars(first, last, out);
+        if (ret.ptr != last) {
+            return std::errc::invalid_argument;
+        }
+
+        if (ret.ec == std::errc::result_out_of_range && saturate) {
+            auto negative = *first == '-';
+            out = negative ? std::numeric_limits<T>::lowest() :
+                             std::numeric_limits<T>::max();
+
+            if constexpr (std::is_floating_point_v<T>) {
+                // Underflow is out of range as well, tell it from overflow
+                // by the magnitude of the value
+                std::string buf(first, last);
+                if (std::fabs(std::strtod(buf.c_str(), nullptr)) < 1) {
+                    out = negative ? -T(0) : T(0);
+                }
+            }
+
+            return std::errc();
+        }
+
+        return ret.ec;
+    } else {
+        // Floating point from_chars is missing in older standard libraries
+        if (std::isspace(static_cast<unsigned char>(*first))) {
+            return std::errc::invalid_argument;
+        }
+
+        std::string buf(first, last);
+        char *end = nullptr;
+        errno = 0;
+
+        if constexpr (std::is_same_v<T, float>) {
+            out = std::strtof(buf.c_str(), &end);
+        } else {
+            out = static_cast<T>(std::strtod(buf.c_str(), &end));
+        }
+
+        if (end != buf.c_str() + buf.size()) {
+            return std::errc::invalid_argument;
+        }
+
+        if (errno == ERANGE) {
+            if (!saturate) {
+                return std::errc::result_out_of_range;
+            }
+
+            // Underflow already gives zero or a subnormal value
+            if (std::isinf(out)) {
+                out = out < 0 ? std::numeric_limits<T>::lowest() :
+                                std::numeric_limits<T>::max();
+            }
+        }
+
+        return std::errc();
+    }
+}
+
+/// \brief Parse exactly `n` decimal digits
+inline bool parse_digits(const char *p, int n, int &out) noexcept
+{
+    int v = 0;
+    for (int i = 0; i != n; ++i) {
+        auto d = p[i] - '0';
+        if (d < 0 || d > 9) {
+            return false;
+        }
+        v = v * 10 + d;
+    }
+    out = v;
+
+    return true;
+}
+
+/// \brief Days since 1970-01-01 of a date in the proleptic Gregorian
+/// calendar
+inline constexpr std::int64_t days_from_civil(
+    std::int64_t y, int m, int d) noexcept
+{
+    if (m <= 2) {
+        --y;
+    }
+
+    auto era = (y >= 0 ? y : y - 399) / 400;
+    auto yoe = y - era * 400;
+    auto doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    auto doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+inline constexpr int days_in_month(int y, int m) noexcept
+{
+    if (m == 2) {
+        return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0 ? 29 : 28;
+    }
+
+    return m == 4 || m == 6 || m == 9 || m == 11 ? 30 : 31;
+}
+
+/// \brief Parse `YYYY-MM-DD` into days since the epoch
+inline bool parse_iso_date(
+    const char *&p, const char *last, std::int64_t &days) noexcept
+{
+    int y = 0;
+    int m = 0;
+    int d = 0;
+
+    if (last - p < 10 || p[4] != '-' || p[7] != '-' ||
+        !parse_digits(p, 4, y) || !parse_digits(p + 5, 2, m) ||
+        !parse_digits(p + 8, 2, d)) {
+        return false;
+    }
+
+    if (m < 1 || m > 12 || d < 1 || d > days_in_month(y, m)) {
+        return false;
+    }
+
+    days = days_from_civil(y, m, d);
+    p += 10;
+
+    return true;
+}
+
+/// \brief Parse `hh:mm[:ss[.fffffffff]]` into nanoseconds since midnight
+inline bool parse_iso_clock(
+    const char *&p, const char *last, std::int64_t &nanos) noexcept
+{
+    int h = 0;
+    int m = 0;
+    int s = 0;
+
+    if (last - p < 5 || p[2] != ':' || !parse_digits(p, 2, h) ||
+        !parse_digits(p + 3, 2, m) || h > 23 || m > 59) {
+        return false;
+    }
+    p += 5;
+
+    if (p != last && *p == ':') {
+        if (last - p < 3 || !parse_digits(p + 1, 2, s) || s > 59) {
+            return false;
+        }
+        p += 3;
+    }
+
+    std::int64_t frac = 0;
+    if (p != last && *p == '.') {
+        ++p;
+        std::int64_t scale = 1'000'000'000;
+        auto q = p;
+        while (p != last && p - q < 9) {
+            auto d = *p - '0';
+            if (d < 0 || d > 9) {
+                break;
+            }
+            scale /= 10;
+            frac += d * scale;
+            ++p;
+        }
+
+        if (p == q) {
+            return false;
+        }
+    }
+
+    nanos = ((h * INT64_C(60) + m) * 60 + s) * 1'000'000'000 + frac;
+
+    return true;
+}
+
+/// \brief Parse an optional `Z`, `±hh:mm`, `±hhmm` or `±hh` suffix into an
+/// offset from UTC in seconds
+inline bool parse_iso_zone(
+    const char *&p, const char *last, std::int64_t &offset) noexcept
+{
+    offset = 0;
+
+    if (p == last) {
+        return true;
+    }
+
+    if (*p == 'Z') {
+        ++p;
+        return true;
+    }
+
+    if (*p != '+' && *p != '-') {
+        return false;
+    }
+
+    auto sign = *p == '-' ? -1 : 1;
+    ++p;
+
+    int h = 0;
+    int m = 0;
+    if (last - p < 2 || !parse_digits(p, 2, h) || h > 23) {
+        return false;
+    }
+    p += 2;
+
+    if (p != last && *p == ':') {
+        ++p;
+    }
+
+    if (p != last) {
+        if (last - p < 2 || !parse_digits(p, 2, m) || m > 59) {
+            return false;
+        }
+        p += 2;
+    }
+
+    offset = sign * (h * 3600 + m * 60);
+
+    return true;
+}
+
+/// \brief Parse an ISO-8601 date or date and time, such as
+/// `2019-07-01T09:30:00.123456789+08:00`, into seconds since the epoch and
+/// nanoseconds within the second
+///
+/// The layout is fixed: a four digit year, a `T` or space before the time,
+/// up to nine fractional digits and an optional zone
+inline bool parse_iso_timestamp(const char *first, const char *last,
+    std::int64_t &seconds, std::int64_t &nanos) noexcept
+{
+    auto p = first;
+
+    std::int64_t days = 0;
+    if (!parse_iso_date(p, last, days)) {
+        return false;
+    }
+
+    std::int64_t clock = 0;
+    std::int64_t offset = 0;
+    if (p != last) {
+        if ((*p != 'T' && *p != ' ') || !parse_iso_clock(++p, last, clock) ||
+            !parse_iso_zone(p, last, offset) || p != last) {
+            return false;
+        }
+    }
+
+    seconds = days * 86400 + clock / 1'000'000'000 - offset;
+    nanos = clock % 1'000'000'000;
+
+    return true;
+}
+
+/// \brief Express a point in time in ticks of `unit` nanoseconds, rounding
+/// towards negative infinity
+template <typename V>
+inline std::errc scale_time(
+    std::int64_t seconds, std::int64_t nanos, std::int64_t unit, V &out)
+{
+    constexpr std::int64_t nanos_per_second = 1'000'000'000;
+
+    std::int64_t v = 0;
+    if (unit >= nanos_per_second) {
+        auto ratio = unit / nanos_per_second;
+        v = seconds / ratio;
+        if (seconds % ratio < 0) {
+            --v;
+        }
+    } else {
+        auto ratio = nanos_per_second / unit;
+        if (seconds > std::numeric_limits<std::int64_t>::max() / ratio - 1 ||
+            seconds < std::numeric_limits<std::int64_t>::min() / ratio + 1) {
+            return std::errc::result_out_of_range;
+        }
+        v = seconds * ratio + nanos / unit;
+    }
+
+    if constexpr (sizeof(V) < sizeof(std::int64_t)) {
+        if (v < std::numeric_limits<V>::min() ||
+            v > std::numeric_limits<V>::max()) {
+            return std::errc::result_out_of_range;
+        }
+    }
+
+    out = static_cast<V>(v);
+
+    return std::errc();
+}
+
+/// \brief Parse a string into the storage of `T`
+template <typename T>
+struct Parser {
+    using value_type = T;
+
+    static std::errc parse(
+        const char *first, const char *last, bool saturate, T &out)
+    {
+        return parse_number(first, last, saturate, out);
+    }
+};
+
+/// \brief Dates are whole days, a time of day is dropped by rounding
+/// towards negative infinity, also when stored in milliseconds
+template <DateUnit Unit>
+struct Parser<Datestamp<Unit>> {
+    using value_type = typename Datestamp<Unit>::value_type;
+
+    static std::errc parse(
+        const char *first, const char *last, bool, value_type &out)
+    {
+        std::int64_t seconds = 0;
+        std::int64_t nanos = 0;
+        if (!parse_iso_timestamp(first, last, seconds, nanos)) {
+            return std::errc::invalid_argument;
+        }
+
+        std::int64_t days = 0;
+        auto ec = scale_time(
+            seconds, nanos, time_unit_nanos(DateUnit::Day), days);
+        if (ec != std::errc()) {
+            return ec;
+        }
+
+        auto ticks = time_unit_nanos(DateUnit::Day) / time_unit_nanos(Unit);
+        if (days > std::numeric_limits<value_type>::max() / ticks ||
+            days < std::numeric_limits<value_type>::min() / ticks) {
+            return std::errc::result_out_of_range;
+        }
+
+        out = static_cast<value_type>(days * ticks);
+
+        return std::errc();
+    }
+};
+
+template <TimeUnit Unit>
+struct Parser<Timestamp<Unit>> {
+    using value_type = typename Timestamp<Unit>::value_type;
+
+    static std::errc parse(
+        const char *first, const char *last, bool, value_type &out)
+    {
+        std::int64_t seconds = 0;
+        std::int64_t nanos = 0;
+        if (!parse_iso_timestamp(first, last, seconds, nanos)) {
+            return std::errc::invalid_argument;
+        }
+
+        return scale_time(seconds, nanos, time_unit_nanos(Unit), out);
+    }
+};
+
+template <TimeUnit Unit>
+struct Parser<Time<Unit>> {
+    using value_type = typename Time<Unit>::value_type;
+
+    static std::errc parse(
+        const char *first, const char *last, bool, value_type &out)
+    {
+        std::int64_t clock = 0;
+        if (!parse_iso_clock(first, last, clock) || first != last) {
+            return std::errc::invalid_argument;
+        }
+
+        out = static_cast<value_type>(clock / time_unit_nanos(Unit));
+
+        return std::errc();
+    }
+};
+
+} // namespace internal
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_CAST_PARSE_HPP
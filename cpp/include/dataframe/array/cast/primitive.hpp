@@ -17,21 +17,553 @@
 #ifndef DATAFRAME_ARRAY_CAST_PRIMITIVE_HPP
 #define DATAFRAME_ARRAY_CAST_PRIMITIVE_HPP
 
+#include <dataframe/array/cast/parse.hpp>
 #include <dataframe/array/type.hpp>
 #include <dataframe/error.hpp>
+#include <arrow/util/parallel.h>
+#include <algorithm>
 #include <iterator>
+#include <limits>
+#include <vector>
 
 namespace dataframe {
 
+/// \brief How numeric casts treat values out of the range of the target
+enum class CastPolicy {
+    Unchecked, ///< Convert as `static_cast` does, narrowing silently wraps,
+               ///< floating point out of the target range saturates
+    Checked,   ///< Throw if any valid value is out of range
+    Saturate   ///< Clamp to the target range, NaN becomes zero
+};
+
+namespace internal {
+
+/// \brief Bounds checks of converting values of `U` into `T`
+template <typename T, typename U>
+struct CastRange {
+    static constexpr bool is_narrowing = std::is_integral_v<T>
+        ? !std::is_integral_v<U> ||
+            (std::is_signed_v<U> && !std::is_signed_v<T>) ||
+            sizeof(U) > sizeof(T) ||
+            (sizeof(U) == sizeof(T) && std::is_signed_v<U> !=
+                    std::is_signed_v<T>)
+        : std::is_floating_point_v<U> && sizeof(U) > sizeof(T);
+
+    static constexpr bool below(U v) noexcept
+    {
+        if constexpr (!is_narrowing) {
+            return false;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return v < -static_cast<U>(std::numeric_limits<T>::max()) &&
+                v > -std::numeric_limits<U>::infinity();
+        } else if constexpr (std::is_floating_point_v<U>) {
+            return v < static_cast<U>(std::numeric_limits<T>::lowest());
+        } else if constexpr (std::is_signed_v<U> && !std::is_signed_v<T>) {
+            return v < 0;
+        } else if constexpr (std::is_signed_v<T> == std::is_signed_v<U>) {
+            return v < std::numeric_limits<T>::lowest();
+        } else {
+            return false;
+        }
+    }
+
+    static constexpr bool above(U v) noexcept
+    {
+        if constexpr (!is_narrowing) {
+            return false;
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return v > static_cast<U>(std::numeric_limits<T>::max()) &&
+                v < std::numeric_limits<U>::infinity();
+        } else if constexpr (std::is_floating_point_v<U>) {
+            // 2^digits is exact in floating point
+            constexpr U hi = static_cast<U>(
+                                 std::numeric_limits<T>::max() / 2 + 1) *
+                2;
+            return v >= hi;
+        } else if constexpr (std::is_signed_v<T> == std::is_signed_v<U>) {
+            return v > std::numeric_limits<T>::max();
+        } else if constexpr (std::is_signed_v<U>) {
+            return v > 0 &&
+                static_cast<std::make_unsigned_t<U>>(v) >
+                std::numeric_limits<T>::max();
+        } else {
+            return v > static_cast<std::make_unsigned_t<T>>(
+                           std::numeric_limits<T>::max());
+        }
+    }
+
+    static constexpr bool invalid(U v) noexcept
+    {
+        if constexpr (std::is_integral_v<T> && std::is_floating_point_v<U>) {
+            return v != v || below(v) || above(v);
+        } else {
+            return below(v) || above(v);
+        }
+    }
+
+    static constexpr T saturate(U v) noexcept
+    {
+        if constexpr (std::is_integral_v<T> && std::is_floating_point_v<U>) {
+            if (v != v) {
+                return 0;
+            }
+        }
+
+        return below(v) ? std::numeric_limits<T>::lowest() :
+                          above(v) ? std::numeric_limits<T>::max() :
+                                     static_cast<T>(v);
+    }
+};
+
+/// \brief Fixed-width types whose values are stored exactly as Arrow lays out
+/// the array data, bool is excluded since Arrow packs it into bits
+template <typename T, typename = void>
+struct IsZeroCopyType : std::false_type {
+};
+
+template <typename T>
+struct IsZeroCopyType<T,
+    std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>>
+    : std::true_type {
+};
+
+template <typename T>
+struct IsZeroCopyType<T, std::void_t<typename T::value_type>>
+    : std::bool_constant<
+          std::is_base_of_v<TimeType<typename T::value_type>, T> &&
+          sizeof(T) == sizeof(typename T::value_type)> {
+};
+
+/// \brief Conversion loops over raw values, written without branches so
+/// that they vectorize
+///
+/// Converting a floating point value out of the range of the target type is
+/// undefined behavior, so such conversions always saturate
+template <typename T, typename U>
+inline void cast_unchecked(const U *src, std::int64_t n, T *dst) noexcept
+{
+    for (std::int64_t i = 0; i != n; ++i) {
+        if constexpr (CastRange<T, U>::is_narrowing &&
+            std::is_floating_point_v<U>) {
+            dst[i] = CastRange<T, U>::saturate(src[i]);
+        } else {
+            dst[i] = static_cast<T>(src[i]);
+        }
+    }
+}
+
+template <typename T, typename U>
+inline void cast_saturate(const U *src, std::int64_t n, T *dst) noexcept
+{
+    for (std::int64_t i = 0; i != n; ++i) {
+        dst[i] = CastRange<T, U>::saturate(src[i]);
+    }
+}
+
+template <typename T, typename U>
+inline bool cast_checked(const U *src, std::int64_t n, T *dst) noexcept
+{
+    bool invalid = false;
+    for (std::int64_t i = 0; i != n; ++i) {
+        invalid |= CastRange<T, U>::invalid(src[i]);
+        dst[i] = CastRange<T, U>::saturate(src[i]);
+    }
+
+    return !invalid;
+}
+
+/// \brief The validity bitmap of an array without copying when its offset is
+/// a whole number of bytes
+inline ::arrow::Status share_null_bitmap(const ::arrow::Array &array,
+    ::arrow::MemoryPool *pool, std::shared_ptr<::arrow::Buffer> *out)
+{
+    if (array.null_count() == 0) {
+        *out = nullptr;
+        return ::arrow::Status::OK();
+    }
+
+    auto offset = array.offset();
+    if (offset % 8 == 0) {
+        *out = offset == 0 ?
+            array.null_bitmap() :
+            ::arrow::SliceBuffer(array.null_bitmap(), offset / 8,
+                ::arrow::BitUtil::BytesForBits(array.length()));
+        return ::arrow::Status::OK();
+    }
+
+    return ::arrow::internal::CopyBitmap(pool, array.null_bitmap()->data(),
+        offset, array.length(), out);
+}
+
+template <typename T, typename ArrayType>
+inline ::arrow::Status cast_numeric(const ArrayType &array, CastPolicy policy,
+    ::arrow::MemoryPool *pool, std::shared_ptr<::arrow::Array> *out)
+{
+    using U = typename ArrayType::TypeClass::c_type;
+
+    auto n = array.length();
+    auto src = array.raw_values();
+
+    std::shared_ptr<::arrow::Buffer> values;
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(
+        pool, n * static_cast<std::int64_t>(sizeof(T)), &values));
+    auto dst = reinterpret_cast<T *>(
+        dynamic_cast<::arrow::MutableBuffer &>(*values).mutable_data());
+
+    switch (policy) {
+        case CastPolicy::Unchecked:
+            cast_unchecked(src, n, dst);
+            break;
+        case CastPolicy::Saturate:
+            cast_saturate(src, n, dst);
+            break;
+        case CastPolicy::Checked:
+            if (!cast_checked(src, n, dst)) {
+                // Out of range values in null slots do not count
+                for (std::int64_t i = 0; i != n; ++i) {
+                    if (array.IsValid(i) &&
+                        CastRange<T, U>::invalid(src[i])) {
+                        return ::arrow::Status::Invalid("Value ", +src[i],
+                            " at position ", i, " is out of range of ",
+                            make_data_type<T>()->ToString());
+                    }
+                }
+            }
+            break;
+    }
+
+    std::shared_ptr<::arrow::Buffer> null_bitmap;
+    ARROW_RETURN_NOT_OK(share_null_bitmap(array, pool, &null_bitmap));
+
+    *out = ::arrow::MakeArray(::arrow::ArrayData::Make(make_data_type<T>(), n,
+        {std::move(null_bitmap), std::move(values)}, array.null_count()));
+
+    return ::arrow::Status::OK();
+}
+
+/// \brief Rows parsed by each task of a string cast, a multiple of eight so
+/// that tasks write disjoint bytes of the validity bitmap
+constexpr std::int64_t parse_block_size = 1 << 14;
+
+/// \brief Parse a string array into `T`
+///
+/// Strings that fail to parse become nulls, or an error if `policy` is
+/// `Checked`. Columns longer than one block are parsed in parallel
+template <typename T>
+inline ::arrow::Status parse_array(const ::arrow::BinaryArray &array,
+    CastPolicy policy, ::arrow::MemoryPool *pool,
+    std::shared_ptr<::arrow::Array> *out)
+{
+    using V = typename Parser<T>::value_type;
+
+    auto n = array.length();
+    auto saturate = policy == CastPolicy::Saturate;
+
+    std::shared_ptr<::arrow::Buffer> values;
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(
+        pool, n * static_cast<std::int64_t>(sizeof(V)), &values));
+    auto dst = reinterpret_cast<V *>(
+        dynamic_cast<::arrow::MutableBuffer &>(*values).mutable_data());
+
+    auto nbytes = ::arrow::BitUtil::BytesForBits(n);
+    std::shared_ptr<::arrow::Buffer> null_bitmap;
+    ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(pool, nbytes, &null_bitmap));
+    auto valid =
+        dynamic_cast<::arrow::MutableBuffer &>(*null_bitmap).mutable_data();
+    if (nbytes != 0) {
+        valid[nbytes - 1] = 0;
+    }
+
+    auto nblocks = (n + parse_block_size - 1) / parse_block_size;
+    std::vector<std::int64_t> null_counts(static_cast<std::size_t>(nblocks));
+    std::vector<std::int64_t> failures(static_cast<std::size_t>(nblocks), -1);
+
+    auto parse_block = [&](int b) {
+        auto k = static_cast<std::size_t>(b);
+        auto begin = b * parse_block_size;
+        auto end = std::min(n, begin + parse_block_size);
+
+        std::int64_t nulls = 0;
+        for (auto i = begin; i != end; ++i) {
+            auto ok = false;
+            if (array.IsValid(i)) {
+                auto str = array.GetView(i);
+                auto first = str.data();
+                auto last = first + str.size();
+                ok = Parser<T>::parse(first, last, saturate, dst[i]) ==
+                    std::errc();
+                if (!ok && failures[k] < 0) {
+                    failures[k] = i;
+                }
+            }
+
+            if (!ok) {
+                dst[i] = V();
+                ++nulls;
+            }
+
+            ::arrow::BitUtil::SetBitTo(valid, i, ok);
+        }
+        null_counts[k] = nulls;
+
+        return ::arrow::Status::OK();
+    };
+
+    if (nblocks > 1 && ::arrow::GetCpuThreadPoolCapacity() > 1) {
+        ARROW_RETURN_NOT_OK(::arrow::internal::ParallelFor(
+            static_cast<int>(nblocks), parse_block));
+    } else {
+        for (std::int64_t b = 0; b != nblocks; ++b) {
+            ARROW_RETURN_NOT_OK(parse_block(static_cast<int>(b)));
+        }
+    }
+
+    if (policy == CastPolicy::Checked) {
+        for (auto i : failures) {
+            if (i >= 0) {
+                return ::arrow::Status::Invalid("Cannot parse '",
+                    array.GetString(i), "' at position ", i, " as ",
+                    make_data_type<T>()->ToString());
+            }
+        }
+    }
+
+    std::int64_t null_count = 0;
+    for (auto c : null_counts) {
+        null_count += c;
+    }
+
+    if (null_count == 0) {
+        null_bitmap = nullptr;
+    }
+
+    *out = ::arrow::MakeArray(::arrow::ArrayData::Make(make_data_type<T>(), n,
+        {std::move(null_bitmap), std::move(values)}, null_count));
+
+    return ::arrow::Status::OK();
+}
+
+} // namespace internal
+
+/// \brief How a cast is carried out
+enum class CastKind {
+    Identity,    ///< The array already has the target type
+    Reinterpret, ///< Only the type changes, the buffers are shared
+    Convert      ///< Values are converted into new buffers
+};
+
+namespace internal {
+
+/// \brief Nanoseconds per tick of date and time types, or zero for other
+/// types
+inline std::int64_t type_unit_nanos(const ::arrow::DataType &type)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type.id()) {
+        case ::arrow::Type::DATE32:
+            return time_unit_nanos(DateUnit::Day);
+        case ::arrow::Type::DATE64:
+            return time_unit_nanos(DateUnit::Millisecond);
+        case ::arrow::Type::TIMESTAMP:
+            return time_unit_nanos(
+                static_cast<const ::arrow::TimestampType &>(type).unit());
+        case ::arrow::Type::TIME32:
+        case ::arrow::Type::TIME64:
+            return time_unit_nanos(
+                static_cast<const ::arrow::TimeType &>(type).unit());
+        default:
+            return 0;
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+/// \brief Whether a type is a date or timestamp, which count from the
+/// epoch, as opposed to a time of day
+inline bool is_epoch_type(const ::arrow::DataType &type)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type.id()) {
+        case ::arrow::Type::DATE32:
+        case ::arrow::Type::DATE64:
+        case ::arrow::Type::TIMESTAMP:
+            return true;
+        default:
+            return false;
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+inline bool is_integer_type(const ::arrow::DataType &type)
+{
+    return ::arrow::is_integer(type.id());
+}
+
+inline bool is_signed_type(const ::arrow::DataType &type)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type.id()) {
+        case ::arrow::Type::INT8:
+        case ::arrow::Type::INT16:
+        case ::arrow::Type::INT32:
+        case ::arrow::Type::INT64:
+            return true;
+        default:
+            return type_unit_nanos(type) != 0;
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+/// \brief Whether all valid values of an integer array are representable in
+/// `T`, which has the same width but another signedness
+template <typename T, typename ArrayType>
+inline bool in_range(const ArrayType &array)
+{
+    using U = typename ArrayType::TypeClass::c_type;
+    using R = CastRange<T, U>;
+
+    auto n = array.length();
+    auto v = array.raw_values();
+
+    bool invalid = false;
+    for (std::int64_t i = 0; i != n; ++i) {
+        invalid |= R::invalid(v[i]);
+    }
+
+    if (!invalid) {
+        return true;
+    }
+
+    if (array.null_count() == 0) {
+        return false;
+    }
+
+    for (std::int64_t i = 0; i != n; ++i) {
+        if (array.IsValid(i) && R::invalid(v[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+inline bool in_range(const ::arrow::Array &array)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (array.type_id()) {
+        case ::arrow::Type::INT8:
+            return in_range<T>(static_cast<const ::arrow::Int8Array &>(array));
+        case ::arrow::Type::INT16:
+            return in_range<T>(
+                static_cast<const ::arrow::Int16Array &>(array));
+        case ::arrow::Type::INT32:
+            return in_range<T>(
+                static_cast<const ::arrow::Int32Array &>(array));
+        case ::arrow::Type::INT64:
+            return in_range<T>(
+                static_cast<const ::arrow::Int64Array &>(array));
+        case ::arrow::Type::UINT8:
+            return in_range<T>(
+                static_cast<const ::arrow::UInt8Array &>(array));
+        case ::arrow::Type::UINT16:
+            return in_range<T>(
+                static_cast<const ::arrow::UInt16Array &>(array));
+        case ::arrow::Type::UINT32:
+            return in_range<T>(
+                static_cast<const ::arrow::UInt32Array &>(array));
+        case ::arrow::Type::UINT64:
+            return in_range<T>(
+                static_cast<const ::arrow::UInt64Array &>(array));
+        default:
+            return false;
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+/// \brief Change the type of an array without touching its buffers
+template <typename T>
+inline std::shared_ptr<::arrow::Array> reinterpret_array(
+    const ::arrow::Array &array)
+{
+    auto data = array.data()->Copy();
+    data->type = make_data_type<T>();
+
+    return ::arrow::MakeArray(std::move(data));
+}
+
+} // namespace internal
+
+/// \brief Decide how `cast_array<T>` would cast an array
+///
+/// A cast is a reinterpretation when the values keep their meaning with the
+/// same bits: dates and timestamps of the same unit, times of the same unit,
+/// signed integers and dates or times of the same width, and integers of the
+/// same width but another signedness. Unless `policy` is `Unchecked`, the
+/// latter also requires all values to be in range, which needs a scan of the
+/// values, all other decisions only inspect the types
+template <typename T>
+inline CastKind cast_kind(
+    const ::arrow::Array &array, CastPolicy policy = CastPolicy::Unchecked)
+{
+    if (is_type<T>(array)) {
+        return CastKind::Identity;
+    }
+
+    if constexpr (internal::IsZeroCopyType<T>::value &&
+        !std::is_floating_point_v<T>) {
+        auto &from = *array.type();
+        auto to = make_data_type<T>();
+
+        auto fixed = dynamic_cast<const ::arrow::FixedWidthType *>(&from);
+        auto from_width = fixed == nullptr ? 0 : fixed->bit_width();
+        auto to_width = static_cast<int>(sizeof(T) * 8);
+
+        if (from_width != to_width || ::arrow::is_floating(from.id())) {
+            return CastKind::Convert;
+        }
+
+        auto from_nanos = internal::type_unit_nanos(from);
+        auto to_nanos = internal::type_unit_nanos(*to);
+
+        if (from_nanos != 0 && to_nanos != 0) {
+            auto same_kind = internal::is_epoch_type(from) ==
+                internal::is_epoch_type(*to);
+            return same_kind && from_nanos == to_nanos ?
+                CastKind::Reinterpret :
+                CastKind::Convert;
+        }
+
+        auto from_signed = internal::is_signed_type(from);
+        if (!from_signed || !internal::is_signed_type(*to)) {
+            if constexpr (std::is_integral_v<T>) {
+                // Wrapping by static_cast keeps the bits
+                if (internal::is_integer_type(from) &&
+                    (policy == CastPolicy::Unchecked ||
+                        internal::in_range<T>(array))) {
+                    return CastKind::Reinterpret;
+                }
+            }
+
+            return CastKind::Convert;
+        }
+
+        return CastKind::Reinterpret;
+    }
+
+    return CastKind::Convert;
+}
+
 template <typename T>
 struct CastArrayVisitor : ::arrow::ArrayVisitor {
     std::shared_ptr<::arrow::Array> result;
     ::arrow::MemoryPool *pool;
+    CastPolicy policy;
 
-    CastArrayVisitor(
-        std::shared_ptr<::arrow::Array> data, ::arrow::MemoryPool *p)
+    CastArrayVisitor(std::shared_ptr<::arrow::Array> data,
+        ::arrow::MemoryPool *p, CastPolicy c = CastPolicy::Unchecked)
         : result(std::move(data))
         , pool(p)
+        , policy(c)
     {
     }
 
@@ -43,27 +575,8 @@ struct CastArrayVisitor : ::arrow::ArrayVisitor {
         if constexpr (std::is_same_v<T, U>) {                                 \
             return ::arrow::Status::OK();                                     \
         } else {                                                              \
-            auto builder = make_builder<T>(pool);                             \
-                                                                              \
-            ARROW_RETURN_NOT_OK(builder->AppendValues(                        \
-                array.raw_values(), array.raw_values() + array.length()));    \
-                                                                              \
-            ARROW_RETURN_NOT_OK(builder->Finish(&result));                    \
-                                                                              \
-            if (array.null_count() != 0) {                                    \
-                auto data = result->data()->Copy();                           \
-                                                                              \
-                data->null_count = array.null_count();                        \
-                                                                              \
-                ARROW_RETURN_NOT_OK(::arrow::internal::CopyBitmap(pool,       \
-                    array.null_bitmap()->data(), array.offset(),              \
-                    array.length(), &data->buffers[0]));                      \
-                                                                              \
-                result = ::arrow::MakeArray(std::move(data));                 \
-            }                                                                 \
+            return internal::cast_numeric<T>(array, policy, pool, &result);   \
         }                                                                     \
-                                                                              \
-        return ::arrow::Status::OK();                                         \
     }
 
     DF_DEFINE_VISITOR(Int8)
@@ -78,6 +591,16 @@ struct CastArrayVisitor : ::arrow::ArrayVisitor {
     DF_DEFINE_VISITOR(Double)
 
 #undef DF_DEFINE_VISITOR
+
+    ::arrow::Status Visit(const ::arrow::StringArray &array) override
+    {
+        if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) {
+            return internal::parse_array<T>(array, policy, pool, &result);
+        } else {
+            return ::arrow::Status::NotImplemented(
+                "Parsing strings as ", make_data_type<T>()->ToString());
+        }
+    }
 };
 
 template <typename T>
@@ -85,8 +608,13 @@ inline std::shared_ptr<::arrow::Array> cast_array(
     std::shared_ptr<::arrow::Array> data,
     ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
-    if (is_type<T>(data)) {
-        return data;
+    switch (cast_kind<T>(*data)) {
+        case CastKind::Identity:
+            return data;
+        case CastKind::Reinterpret:
+            return internal::reinterpret_array<T>(*data);
+        case CastKind::Convert:
+            break;
     }
 
     CastArrayVisitor<T> visitor(std::move(data), pool);
@@ -95,6 +623,32 @@ inline std::shared_ptr<::arrow::Array> cast_array(
     return std::move(visitor.result);
 }
 
+/// \brief Cast a numeric or string array to the numeric, date or time type
+/// `T`, with out of range values and strings that fail to parse handled
+/// according to `policy`
+template <typename T>
+inline std::shared_ptr<::arrow::Array> cast_array(
+    std::shared_ptr<::arrow::Array> data, CastPolicy policy,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    static_assert(internal::IsZeroCopyType<T>::value,
+        "Cast policies apply to numeric, date and time types");
+
+    switch (cast_kind<T>(*data, policy)) {
+        case CastKind::Identity:
+            return data;
+        case CastKind::Reinterpret:
+            return internal::reinterpret_array<T>(*data);
+        case CastKind::Convert:
+            break;
+    }
+
+    CastArrayVisitor<T> visitor(std::move(data), pool, policy);
+    DF_ARROW_ERROR_HANDLER(visitor.result->Accept(&visitor));
+
+    return std::move(visitor.result);
+}
+
 } // namespace dataframe
 
 #endif // DATAFRAME_ARRAY_CAST_PRIMITIVE_HPP
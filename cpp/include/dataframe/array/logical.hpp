@@ -0,0 +1,187 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_LOGICAL_HPP
+#define DATAFRAME_ARRAY_LOGICAL_HPP
+
+#include <dataframe/array/view.hpp>
+#include <cstring>
+
+namespace dataframe {
+
+namespace internal {
+
+struct LogicalAnd {
+    template <typename T>
+    T operator()(T x, T y) const noexcept
+    {
+        return static_cast<T>(x & y);
+    }
+};
+
+struct LogicalOr {
+    template <typename T>
+    T operator()(T x, T y) const noexcept
+    {
+        return static_cast<T>(x | y);
+    }
+};
+
+struct LogicalXor {
+    template <typename T>
+    T operator()(T x, T y) const noexcept
+    {
+        return static_cast<T>(x ^ y);
+    }
+};
+
+struct LogicalNot {
+    template <typename T>
+    T operator()(T x, T) const noexcept
+    {
+        return static_cast<T>(~x);
+    }
+};
+
+/// \brief Apply a bitwise operation to the values of two boolean views, an
+/// element is null if it is null in either view
+///
+/// When both arrays start at a whole byte the values are combined a byte at a
+/// time in a loop the compiler vectorizes, otherwise a 64-bit word at a time
+template <typename Op>
+inline std::shared_ptr<::arrow::Array> logical_op(const ArrayView<bool> &v1,
+    const ArrayView<bool> &v2, Op op, ::arrow::MemoryPool *pool)
+{
+    if (v1.size() != v2.size()) {
+        throw DataFrameException("Boolean arrays of different lengths");
+    }
+
+    auto n = static_cast<std::int64_t>(v1.size());
+    auto nwords = v1.nwords();
+    auto nbytes = static_cast<std::int64_t>(nwords * 8);
+
+    std::shared_ptr<::arrow::Buffer> values;
+    DF_ARROW_ERROR_HANDLER(::arrow::AllocateBuffer(pool, nbytes, &values));
+    auto dst = dynamic_cast<::arrow::MutableBuffer &>(*values).mutable_data();
+
+    auto &d1 = *v1.data()->data();
+    auto &d2 = *v2.data()->data();
+
+    if (n != 0 && d1.offset % 8 == 0 && d2.offset % 8 == 0) {
+        auto p1 = d1.buffers[1]->data() + d1.offset / 8;
+        auto p2 = d2.buffers[1]->data() + d2.offset / 8;
+        auto m = ::arrow::BitUtil::BytesForBits(n);
+        for (std::int64_t i = 0; i != m; ++i) {
+            dst[i] = op(p1[i], p2[i]);
+        }
+        if (n % 8 != 0) {
+            dst[m - 1] = static_cast<std::uint8_t>(
+                dst[m - 1] & ((1U << (n % 8)) - 1));
+        }
+        std::memset(dst + m, 0, static_cast<std::size_t>(nbytes - m));
+    } else {
+        for (std::size_t k = 0; k != nwords; ++k) {
+            auto w = op(v1.word(k), v2.word(k));
+            if (k + 1 == nwords && n % 64 != 0) {
+                w &= (UINT64_C(1) << (n % 64)) - 1;
+            }
+            w = ::arrow::BitUtil::ToLittleEndian(w);
+            std::memcpy(dst + k * 8, &w, sizeof(w));
+        }
+    }
+
+    std::shared_ptr<::arrow::Buffer> null_bitmap;
+    std::int64_t null_count = 0;
+    if (d1.GetNullCount() != 0 || d2.GetNullCount() != 0) {
+        DF_ARROW_ERROR_HANDLER(
+            ::arrow::AllocateBuffer(pool, nbytes, &null_bitmap));
+        auto &bitmap = dynamic_cast<::arrow::MutableBuffer &>(*null_bitmap);
+        auto valid = bitmap.mutable_data();
+
+        std::int64_t count = 0;
+        for (std::size_t k = 0; k != nwords; ++k) {
+            auto w = v1.valid_word(k) & v2.valid_word(k);
+            count += ::arrow::BitUtil::PopCount(w);
+            w = ::arrow::BitUtil::ToLittleEndian(w);
+            std::memcpy(valid + k * 8, &w, sizeof(w));
+        }
+        null_count = n - count;
+    }
+
+    return ::arrow::MakeArray(::arrow::ArrayData::Make(::arrow::boolean(), n,
+        {std::move(null_bitmap), std::move(values)}, null_count));
+}
+
+} // namespace internal
+
+/// \brief Element-wise AND of two boolean arrays of the same length, an
+/// element is null if it is null in either array
+inline std::shared_ptr<::arrow::Array> logical_and(const ArrayView<bool> &v1,
+    const ArrayView<bool> &v2,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    return internal::logical_op(v1, v2, internal::LogicalAnd(), pool);
+}
+
+/// \brief Element-wise OR, nulls are handled as in `logical_and`
+inline std::shared_ptr<::arrow::Array> logical_or(const ArrayView<bool> &v1,
+    const ArrayView<bool> &v2,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    return internal::logical_op(v1, v2, internal::LogicalOr(), pool);
+}
+
+/// \brief Element-wise XOR, nulls are handled as in `logical_and`
+inline std::shared_ptr<::arrow::Array> logical_xor(const ArrayView<bool> &v1,
+    const ArrayView<bool> &v2,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    return internal::logical_op(v1, v2, internal::LogicalXor(), pool);
+}
+
+/// \brief Element-wise NOT, null elements stay null
+inline std::shared_ptr<::arrow::Array> logical_not(const ArrayView<bool> &v,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    return internal::logical_op(v, v, internal::LogicalNot(), pool);
+}
+
+inline ArrayView<bool> operator&(
+    const ArrayView<bool> &v1, const ArrayView<bool> &v2)
+{
+    return ArrayView<bool>(logical_and(v1, v2));
+}
+
+inline ArrayView<bool> operator|(
+    const ArrayView<bool> &v1, const ArrayView<bool> &v2)
+{
+    return ArrayView<bool>(logical_or(v1, v2));
+}
+
+inline ArrayView<bool> operator^(
+    const ArrayView<bool> &v1, const ArrayView<bool> &v2)
+{
+    return ArrayView<bool>(logical_xor(v1, v2));
+}
+
+inline ArrayView<bool> operator~(const ArrayView<bool> &v)
+{
+    return ArrayView<bool>(logical_not(v));
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_LOGICAL_HPP
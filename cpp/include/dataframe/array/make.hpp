@@ -26,11 +26,92 @@
 #include <dataframe/array/make/primitive.hpp>
 #include <dataframe/array/make/string.hpp>
 #include <dataframe/array/make/struct.hpp>
+#include <cstring>
+#include <limits>
+#include <vector>
 
 namespace dataframe {
 
 namespace internal {
 
+/// \brief Iterators over contiguous one-byte masks, such as `bool *` and
+/// iterators of `std::vector<std::uint8_t>`
+template <typename Iter, typename V = typename std::iterator_traits<
+                             Iter>::value_type>
+constexpr bool is_byte_mask_v = std::is_integral_v<V> && sizeof(V) == 1 &&
+    (std::is_pointer_v<Iter> ||
+        (!std::is_same_v<V, bool> &&
+            (std::is_same_v<Iter, typename std::vector<V>::iterator> ||
+                std::is_same_v<Iter,
+                    typename std::vector<V>::const_iterator>)));
+
+/// \brief Pack validity flags into a bitmap, a byte at a time
+template <typename Iter>
+inline void pack_bits(
+    Iter iter, std::int64_t begin, std::int64_t length, std::uint8_t *bits)
+{
+    for (auto i = begin; i < length; i += 8) {
+        auto n = std::min<std::int64_t>(8, length - i);
+        unsigned byte = 0;
+        for (std::int64_t j = 0; j != n; ++j, ++iter) {
+            byte |= (static_cast<bool>(*iter) ? 1U : 0U) << j;
+        }
+        bits[i / 8] = static_cast<std::uint8_t>(byte);
+    }
+}
+
+/// \brief Pack one-byte flags, where any non-zero byte is valid, eight at a
+/// time
+inline std::int64_t pack_byte_mask(
+    const std::uint8_t *mask, std::int64_t length, std::uint8_t *bits)
+{
+    constexpr std::uint64_t low = 0x7F7F7F7F7F7F7F7FULL;
+    constexpr std::uint64_t ones = 0x0101010101010101ULL;
+    constexpr std::uint64_t gather = 0x0102040810204080ULL;
+
+    std::int64_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        std::uint64_t x = 0;
+        std::memcpy(&x, mask + i, sizeof(x));
+        x = ::arrow::BitUtil::FromLittleEndian(x);
+
+        // Set the lowest bit of each byte that is non-zero, then gather
+        // those bits into the top byte
+        x = ((((x & low) + low) | x) >> 7) & ones;
+        bits[i / 8] = static_cast<std::uint8_t>((x * gather) >> 56);
+    }
+
+    return i;
+}
+
+#ifdef __GLIBCXX__
+
+/// \brief Copy the words of a `std::vector<bool>`, which libstdc++ stores with
+/// the same bit order as Arrow bitmaps
+inline std::int64_t pack_bit_vector(std::_Bit_type *words, unsigned offset,
+    std::int64_t length, std::uint8_t *bits)
+{
+    constexpr std::int64_t width = std::numeric_limits<std::_Bit_type>::digits;
+
+    std::int64_t i = 0;
+    for (std::size_t k = 0; i + width <= length; i += width, ++k) {
+        auto word = words[k] >> offset;
+        if (offset != 0) {
+            word |= words[k + 1] << (width - offset);
+        }
+        word = ::arrow::BitUtil::ToLittleEndian(word);
+        std::memcpy(bits + i / 8, &word, sizeof(word));
+    }
+
+    return i;
+}
+
+#endif
+
+/// \brief Replace the validity bitmap of an array with flags from `iter`
+///
+/// Contiguous byte masks and `std::vector<bool>` are packed many bits at a
+/// time, and the bitmap is left out altogether when all values are valid
 template <typename Iter>
 inline std::shared_ptr<::arrow::Array> set_mask(
     const std::shared_ptr<::arrow::Array> &array, Iter iter,
@@ -46,18 +127,74 @@ inline std::shared_ptr<::arrow::Array> set_mask(
     auto bits =
         dynamic_cast<::arrow::MutableBuffer &>(*null_bitmap).mutable_data();
 
-    std::int64_t null_count = 0;
-    for (std::int64_t i = 0; i != length; ++i, ++iter) {
-        auto is_valid = *iter;
-        null_count += !is_valid;
-        ::arrow::BitUtil::SetBitTo(bits, i, is_valid);
+    std::int64_t packed = 0;
+    if (length != 0) {
+        if constexpr (is_byte_mask_v<Iter>) {
+            packed = pack_byte_mask(
+                reinterpret_cast<const std::uint8_t *>(&*iter), length, bits);
+#ifdef __GLIBCXX__
+        } else if constexpr (std::is_same_v<Iter,
+                                 std::vector<bool>::iterator> ||
+            std::is_same_v<Iter, std::vector<bool>::const_iterator>) {
+            packed = pack_bit_vector(iter._M_p, iter._M_offset, length, bits);
+#endif
+        }
     }
 
-    data->null_count = null_count;
+    std::advance(iter, packed);
+    pack_bits(iter, packed, length, bits);
+
+    data->null_count =
+        length - ::arrow::internal::CountSetBits(bits, 0, length);
+
+    if (data->null_count == 0) {
+        null_bitmap = nullptr;
+    }
 
     return ::arrow::MakeArray(data);
 }
 
+inline ::arrow::MemoryPool *find_pool(
+    ::arrow::MemoryPool *, ::arrow::MemoryPool *pool)
+{
+    return pool;
+}
+
+template <typename T>
+inline ::arrow::MemoryPool *find_pool(::arrow::MemoryPool *pool, const T &)
+{
+    return pool;
+}
+
+/// \brief The last memory pool among trailing make_array arguments, so the
+/// validity bitmap comes from the same pool as the values
+template <typename... Args>
+inline ::arrow::MemoryPool *trailing_pool(const Args &... args)
+{
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool();
+    ((pool = find_pool(pool, args)), ...);
+
+    return pool;
+}
+
+/// \brief A buffer that owns a vector and exposes its storage
+template <typename V, typename Alloc>
+class VectorBuffer : public ::arrow::Buffer
+{
+  public:
+    explicit VectorBuffer(std::vector<V, Alloc> &&vec)
+        : ::arrow::Buffer(nullptr, 0)
+        , vec_(std::move(vec))
+    {
+        data_ = reinterpret_cast<const std::uint8_t *>(vec_.data());
+        size_ = static_cast<std::int64_t>(vec_.size() * sizeof(V));
+        capacity_ = static_cast<std::int64_t>(vec_.capacity() * sizeof(V));
+    }
+
+  private:
+    std::vector<V, Alloc> vec_;
+};
+
 template <typename V, typename R, typename Iter, typename Member>
 class MemberObjectIterator
 {
@@ -210,17 +347,21 @@ template <typename T, typename Iter, typename Valid, typename... Args>
 inline std::shared_ptr<::arrow::Array> make_array(
     Iter first, Iter last, Valid valid, Args &&... args)
 {
+    auto pool = internal::trailing_pool(args...);
+
     return internal::set_mask(
-        make_array<T>(first, last, std::forward<Args>(args)...), valid);
+        make_array<T>(first, last, std::forward<Args>(args)...), valid, pool);
 }
 
 template <typename T, typename Iter, typename Alloc, typename... Args>
 inline std::shared_ptr<::arrow::Array> make_array(Iter first, Iter last,
     const std::vector<bool, Alloc> &valid, Args &&... args)
 {
+    auto pool = internal::trailing_pool(args...);
+
     return internal::set_mask(
         make_array<T>(first, last, std::forward<Args>(args)...),
-        valid.begin());
+        valid.begin(), pool);
 }
 
 template <typename T, typename V, typename Alloc>
@@ -230,6 +371,26 @@ inline std::shared_ptr<::arrow::Array> make_array(
     return make_array<T>(vec.begin(), vec.end());
 }
 
+/// \brief Make an array that takes over the storage of `vec` without copying
+/// when `V` is either `T` or its scalar type and `T` is fixed-width,
+/// otherwise the values are copied as from an lvalue
+template <typename T, typename V, typename Alloc>
+inline std::shared_ptr<::arrow::Array> make_array(std::vector<V, Alloc> &&vec)
+{
+    if constexpr (internal::IsZeroCopyType<T>::value &&
+        (std::is_same_v<V, T> || std::is_same_v<V, ScalarType<T>>)) {
+        auto length = static_cast<std::int64_t>(vec.size());
+        std::vector<std::shared_ptr<::arrow::Buffer>> buffers{nullptr,
+            std::make_shared<internal::VectorBuffer<V, Alloc>>(
+                std::move(vec))};
+
+        return ::arrow::MakeArray(::arrow::ArrayData::Make(
+            make_data_type<T>(), length, std::move(buffers), 0));
+    } else {
+        return make_array<T>(vec.begin(), vec.end());
+    }
+}
+
 template <typename T, typename V, typename Alloc, typename AllocM>
 inline std::shared_ptr<::arrow::Array> make_array(
     const std::vector<V, Alloc> &vec, const std::vector<bool, AllocM> &mask)
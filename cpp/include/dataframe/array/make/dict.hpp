@@ -18,17 +18,316 @@
 #define DATAFRAME_ARRAY_MAKE_DICT_HPP
 
 #include <dataframe/array/make/primitive.hpp>
+#include <dataframe/array/view.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <unordered_map>
 
 namespace dataframe {
 
+/// \brief Encode values into dictionary arrays with a memo that persists
+/// between calls, so consecutive batches share the same dictionary indices
+///
+/// Values are hashed directly from the source iterator into the index buffer
+/// and the dictionary only grows, hence the dictionary of a batch is always a
+/// prefix of the dictionaries of later batches. New values are appended to
+/// the dictionary buffers, which are shared between batches until they need
+/// to grow. All NaN values share one entry
+template <typename T, typename Index = std::int32_t, bool Ordered = false>
+class DictionaryEncoder
+{
+    static constexpr bool is_binary =
+        std::is_same_v<ScalarType<T>, std::string>;
+
+  public:
+    using key_type =
+        std::conditional_t<is_binary, std::string_view, ScalarType<T>>;
+
+    using value_type = std::conditional_t<is_binary, std::string, T>;
+
+    DictionaryEncoder() = default;
+
+    /// \brief Start with the values of an existing dictionary, which keep
+    /// their positions as indices
+    explicit DictionaryEncoder(
+        const std::shared_ptr<::arrow::Array> &dictionary)
+    {
+        for (auto &&v : make_view<T>(dictionary)) {
+            insert(v);
+        }
+    }
+
+    DictionaryEncoder(const DictionaryEncoder &) = delete;
+    DictionaryEncoder &operator=(const DictionaryEncoder &) = delete;
+
+    /// \brief The number of distinct values seen so far
+    std::size_t size() const { return values_.size(); }
+
+    /// \brief Forget all values
+    void reset()
+    {
+        index_.clear();
+        values_.clear();
+        dictionary_.reset();
+        offsets_ = Storage();
+        data_ = Storage();
+    }
+
+    /// \brief The current dictionary
+    ///
+    /// Non-const since values seen after the last call are appended to the
+    /// cached dictionary buffers
+    std::shared_ptr<::arrow::Array> dictionary(
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+    {
+        auto n = static_cast<std::int64_t>(size());
+        if (dictionary_ != nullptr && dictionary_->length() == n) {
+            return dictionary_;
+        }
+
+        auto m = dictionary_ == nullptr ? 0 : dictionary_->length();
+        auto tail = make_array<T>(values_.begin() + m, values_.end(), pool);
+        auto &type = *tail->type();
+
+        if (type.id() == ::arrow::Type::STRING ||
+            type.id() == ::arrow::Type::BINARY) {
+            auto &values = static_cast<const ::arrow::BinaryArray &>(*tail);
+            auto first = values.value_offset(0);
+            auto base = static_cast<std::int32_t>(data_.size) - first;
+
+            auto step = static_cast<std::int64_t>(sizeof(std::int32_t));
+            if (offsets_.size == 0) {
+                std::int32_t zero = 0;
+                append(&offsets_, &zero, step, pool);
+            }
+
+            for (std::int64_t i = 1; i <= tail->length(); ++i) {
+                auto offset = values.value_offset(i) + base;
+                append(&offsets_, &offset, step, pool);
+            }
+
+            auto bytes = values.value_offset(tail->length()) - first;
+            append(&data_,
+                bytes == 0 ? nullptr : values.value_data()->data() + first,
+                bytes, pool);
+
+            dictionary_ = ::arrow::MakeArray(::arrow::ArrayData::Make(
+                tail->type(), n, {nullptr, offsets_.slice(), data_.slice()},
+                0));
+        } else if (auto width = fixed_width(type); width > 0) {
+            auto &data = *tail->data();
+            auto bytes = tail->length() * width;
+            append(&data_,
+                bytes == 0 ? nullptr :
+                             data.buffers.at(1)->data() + data.offset * width,
+                bytes, pool);
+
+            dictionary_ = ::arrow::MakeArray(::arrow::ArrayData::Make(
+                tail->type(), n, {nullptr, data_.slice()}, 0));
+        } else {
+            dictionary_ = make_array<T>(values_.begin(), values_.end(), pool);
+        }
+
+        return dictionary_;
+    }
+
+    /// \brief Encode values into a dictionary array against the current
+    /// dictionary, adding new values to it
+    template <typename Iter>
+    std::shared_ptr<::arrow::Array> encode(Iter first, Iter last,
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+    {
+        using category =
+            typename std::iterator_traits<Iter>::iterator_category;
+
+        std::shared_ptr<::arrow::Array> indices;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                          category>) {
+            auto n = static_cast<std::int64_t>(std::distance(first, last));
+
+            std::shared_ptr<::arrow::Buffer> buffer;
+            DF_ARROW_ERROR_HANDLER(::arrow::AllocateBuffer(
+                pool, n * static_cast<std::int64_t>(sizeof(Index)), &buffer));
+
+            auto out = reinterpret_cast<Index *>(
+                dynamic_cast<::arrow::MutableBuffer &>(*buffer)
+                    .mutable_data());
+            for (auto iter = first; iter != last; ++iter, ++out) {
+                *out = insert(*iter);
+            }
+
+            indices = ::arrow::MakeArray(
+                ::arrow::ArrayData::Make(make_data_type<Index>(), n,
+                    {nullptr, std::move(buffer)}, 0));
+        } else {
+            std::vector<Index> values;
+            for (auto iter = first; iter != last; ++iter) {
+                values.push_back(insert(*iter));
+            }
+            indices = make_array<Index>(values.begin(), values.end(), pool);
+        }
+
+        return std::make_shared<::arrow::DictionaryArray>(
+            make_data_type<Dict<T, Index, Ordered>>(), indices,
+            dictionary(pool));
+    }
+
+  private:
+    /// \brief Bytes appended to a buffer, which is copied into a buffer of
+    /// twice the size when full, such that the bytes viewed by earlier
+    /// dictionaries never change
+    struct Storage {
+        std::shared_ptr<::arrow::Buffer> buffer;
+        std::int64_t size = 0;
+
+        std::shared_ptr<::arrow::Buffer> slice() const
+        {
+            return buffer == nullptr ? nullptr :
+                                       ::arrow::SliceBuffer(buffer, 0, size);
+        }
+    };
+
+    /// \brief Key hashing and equality treating all NaN as equal
+    struct KeyHash {
+        std::size_t operator()(const key_type &key) const
+        {
+            if constexpr (std::is_floating_point_v<key_type>) {
+                if (std::isnan(key)) {
+                    return 0;
+                }
+            }
+
+            return std::hash<key_type>()(key);
+        }
+    };
+
+    struct KeyEqual {
+        bool operator()(const key_type &k1, const key_type &k2) const
+        {
+            if constexpr (std::is_floating_point_v<key_type>) {
+                if (std::isnan(k1)) {
+                    return std::isnan(k2);
+                }
+            }
+
+            return k1 == k2;
+        }
+    };
+
+    static std::int64_t fixed_width(const ::arrow::DataType &type)
+    {
+        auto fixed = dynamic_cast<const ::arrow::FixedWidthType *>(&type);
+        if (fixed == nullptr || fixed->bit_width() % 8 != 0) {
+            return 0;
+        }
+
+        return fixed->bit_width() / 8;
+    }
+
+    static void append(Storage *storage, const void *data, std::int64_t n,
+        ::arrow::MemoryPool *pool)
+    {
+        auto capacity =
+            storage->buffer == nullptr ? 0 : storage->buffer->size();
+
+        if (storage->buffer == nullptr || storage->size + n > capacity) {
+            capacity = std::max(storage->size + n, 2 * capacity);
+
+            std::shared_ptr<::arrow::Buffer> buffer;
+            DF_ARROW_ERROR_HANDLER(
+                ::arrow::AllocateBuffer(pool, capacity, &buffer));
+
+            if (storage->size != 0) {
+                std::memcpy(buffer->mutable_data(), storage->buffer->data(),
+                    static_cast<std::size_t>(storage->size));
+            }
+            storage->buffer = std::move(buffer);
+        }
+
+        if (n != 0) {
+            std::memcpy(storage->buffer->mutable_data() + storage->size, data,
+                static_cast<std::size_t>(n));
+        }
+        storage->size += n;
+    }
+
+    template <typename V>
+    Index insert(const V &v)
+    {
+        key_type key;
+        if constexpr (is_binary) {
+            key = std::string_view(v);
+        } else {
+            key = static_cast<key_type>(v);
+        }
+
+        auto iter = index_.find(key);
+        if (iter != index_.end()) {
+            return iter->second;
+        }
+
+        if (values_.size() >
+            static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+            throw DataFrameException("Too many values for dictionary index");
+        }
+
+        auto idx = static_cast<Index>(values_.size());
+
+        // Values live in a deque, whose elements never move, so that string
+        // keys may view them
+        if constexpr (is_binary) {
+            values_.emplace_back(key);
+            index_.emplace(values_.back(), idx);
+        } else {
+            values_.emplace_back(v);
+            index_.emplace(key, idx);
+        }
+
+        return idx;
+    }
+
+    std::unordered_map<key_type, Index, KeyHash, KeyEqual> index_;
+    std::deque<value_type> values_;
+    std::shared_ptr<::arrow::Array> dictionary_;
+    Storage offsets_;
+    Storage data_;
+};
+
 template <typename T, typename Index, bool Ordered>
 struct ArrayMaker<Dict<T, Index, Ordered>> {
+    /// \brief Append values to a dictionary builder, which hashes each
+    /// value directly into its memo
     template <typename Iter>
     static void append(
         BuilderType<Dict<T, Index, Ordered>> *builder, Iter first, Iter last)
     {
-        auto array = make_array<T>(first, last);
-        DF_ARROW_ERROR_HANDLER(builder->AppendArray(*array));
+        using U = ScalarType<T>;
+
+        for (auto iter = first; iter != last; ++iter) {
+            auto &&v = *iter;
+            if constexpr (std::is_same_v<U, std::string>) {
+                std::string_view sv(v);
+                DF_ARROW_ERROR_HANDLER(builder->Append(
+                    ::arrow::util::string_view(sv.data(), sv.size())));
+            } else {
+                DF_ARROW_ERROR_HANDLER(builder->Append(static_cast<U>(v)));
+            }
+        }
+    }
+
+    /// \brief Make a dictionary array without going through the Arrow
+    /// builder, with the index type encoded directly
+    template <typename Iter>
+    static std::shared_ptr<::arrow::Array> make(
+        Iter first, Iter last, ::arrow::MemoryPool *pool)
+    {
+        DictionaryEncoder<T, Index, Ordered> encoder;
+
+        return encoder.encode(first, last, pool);
     }
 };
 
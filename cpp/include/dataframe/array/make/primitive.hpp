@@ -31,6 +31,23 @@ struct ArrayMaker {
     }
 };
 
+namespace internal {
+
+/// \brief Whether `ArrayMaker<T>` makes whole arrays itself instead of
+/// appending to an Arrow builder
+template <typename T, typename = void>
+struct HasArrayMake : std::false_type {
+};
+
+template <typename T>
+struct HasArrayMake<T,
+    std::void_t<decltype(ArrayMaker<T>::make(std::declval<const int *>(),
+        std::declval<const int *>(),
+        std::declval<::arrow::MemoryPool *>()))>> : std::true_type {
+};
+
+} // namespace internal
+
 template <bool Cond>
 using EnableMakeArray =
     std::enable_if_t<Cond, std::shared_ptr<::arrow::Array>>;
@@ -41,12 +58,16 @@ inline EnableMakeArray<
 make_array(Iter first, Iter last,
     ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
-    auto builder = make_builder<T>(pool);
-    ArrayMaker<T>::append(builder.get(), first, last);
-    std::shared_ptr<::arrow::Array> ret;
-    DF_ARROW_ERROR_HANDLER(builder->Finish(&ret));
+    if constexpr (internal::HasArrayMake<T>::value) {
+        return ArrayMaker<T>::make(first, last, pool);
+    } else {
+        auto builder = make_builder<T>(pool);
+        ArrayMaker<T>::append(builder.get(), first, last);
+        std::shared_ptr<::arrow::Array> ret;
+        DF_ARROW_ERROR_HANDLER(builder->Finish(&ret));
 
-    return cast_array<T>(ret, pool);
+        return cast_array<T>(ret, pool);
+    }
 }
 
 } // namespace dataframe
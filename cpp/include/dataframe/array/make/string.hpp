@@ -21,18 +21,47 @@
 
 namespace dataframe {
 
+namespace internal {
+
+/// \brief Append binary values, sizing the value buffer exactly when the
+/// input can be traversed twice
+template <typename Builder, typename Iter, typename Get>
+inline void append_binary(Builder *builder, Iter first, Iter last, Get &&get)
+{
+    using category = typename std::iterator_traits<Iter>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+        std::int64_t length = 0;
+        std::int64_t bytes = 0;
+        for (auto iter = first; iter != last; ++iter) {
+            ++length;
+            bytes += static_cast<std::int64_t>(get(*iter).size());
+        }
+
+        DF_ARROW_ERROR_HANDLER(builder->Reserve(length));
+        DF_ARROW_ERROR_HANDLER(builder->ReserveData(bytes));
+    }
+
+    // Single pass input falls back to the geometric growth of the builder
+    for (auto iter = first; iter != last; ++iter) {
+        auto &&value = *iter;
+        auto &&v = get(value);
+        DF_ARROW_ERROR_HANDLER(
+            builder->Append(reinterpret_cast<const std::uint8_t *>(v.data()),
+                static_cast<std::int32_t>(v.size())));
+    }
+}
+
+} // namespace internal
+
 template <>
 struct ArrayMaker<std::string> {
     template <typename Iter>
     static void append(
         BuilderType<std::string> *builder, Iter first, Iter last)
     {
-        DF_ARROW_ERROR_HANDLER(builder->Reserve(std::distance(first, last)));
-        for (auto iter = first; iter != last; ++iter) {
-            std::string_view v(*iter);
-            DF_ARROW_ERROR_HANDLER(builder->Append(
-                v.data(), static_cast<std::int32_t>(v.size())));
-        }
+        internal::append_binary(builder, first, last,
+            [](auto &&v) { return std::string_view(v); });
     }
 };
 
@@ -45,11 +74,8 @@ struct ArrayMaker<Bytes> {
     template <typename Iter>
     static void append(BuilderType<Bytes> *builder, Iter first, Iter last)
     {
-        DF_ARROW_ERROR_HANDLER(builder->Reserve(std::distance(first, last)));
-        for (auto iter = first; iter != last; ++iter) {
-            DF_ARROW_ERROR_HANDLER(builder->Append(
-                iter->data(), static_cast<std::int32_t>(iter->size())));
-        }
+        internal::append_binary(builder, first, last,
+            [](auto &&v) -> decltype(auto) { return (v); });
     }
 };
 
@@ -0,0 +1,150 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_MEMORY_HPP
+#define DATAFRAME_ARRAY_MEMORY_HPP
+
+#include <dataframe/error.hpp>
+#include <arrow/api.h>
+#include <unordered_map>
+
+namespace dataframe {
+
+namespace internal {
+
+/// \brief Bytes of the buffers of `data` used by the elements in
+/// `[offset, offset + length)`, with `offset` counted from the start of the
+/// buffers
+inline std::int64_t slice_bytes(
+    const std::shared_ptr<::arrow::ArrayData> &data, std::int64_t offset,
+    std::int64_t length)
+{
+    constexpr auto offset_width =
+        static_cast<std::int64_t>(sizeof(std::int32_t));
+
+    std::int64_t ret = 0;
+
+    if (!data->buffers.empty() && data->buffers[0] != nullptr) {
+        ret += ::arrow::BitUtil::BytesForBits(length);
+    }
+
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (data->type->id()) {
+        case ::arrow::Type::NA:
+            break;
+        case ::arrow::Type::STRING:
+        case ::arrow::Type::BINARY: {
+            ret += (length + 1) * offset_width;
+            if (data->buffers[1] != nullptr) {
+                auto offsets = reinterpret_cast<const std::int32_t *>(
+                    data->buffers[1]->data());
+                ret += offsets[offset + length] - offsets[offset];
+            }
+        } break;
+        case ::arrow::Type::LIST: {
+            ret += (length + 1) * offset_width;
+            if (data->buffers[1] != nullptr) {
+                auto offsets = reinterpret_cast<const std::int32_t *>(
+                    data->buffers[1]->data());
+                auto &child = data->child_data.at(0);
+                ret += slice_bytes(child, child->offset + offsets[offset],
+                    offsets[offset + length] - offsets[offset]);
+            }
+        } break;
+        case ::arrow::Type::STRUCT:
+            for (auto &&child : data->child_data) {
+                ret += slice_bytes(child, child->offset + offset, length);
+            }
+            break;
+        case ::arrow::Type::DICTIONARY: {
+            // The dictionary is shared by all slices and counted in full
+            auto &type =
+                static_cast<const ::arrow::DictionaryType &>(*data->type);
+            auto &index =
+                static_cast<const ::arrow::FixedWidthType &>(
+                    *type.index_type());
+            ret += ::arrow::BitUtil::BytesForBits(length * index.bit_width());
+
+            auto dict = ::arrow::DictionaryArray(data).dictionary()->data();
+            ret += slice_bytes(dict, dict->offset, dict->length);
+        } break;
+        default: {
+            auto fixed = dynamic_cast<const ::arrow::FixedWidthType *>(
+                data->type.get());
+            if (fixed != nullptr) {
+                ret += ::arrow::BitUtil::BytesForBits(
+                    length * fixed->bit_width());
+            } else {
+                for (auto &&buf : data->buffers) {
+                    if (buf != nullptr) {
+                        ret += buf->size();
+                    }
+                }
+                for (auto &&child : data->child_data) {
+                    ret += slice_bytes(child, child->offset, child->length);
+                }
+            }
+        } break;
+    }
+    DF_DIAGNOSTIC_POP
+
+    return ret;
+}
+
+/// \brief Record the allocations underlying the buffers of `data`, slices
+/// of a buffer are traced back to their parent
+inline void collect_buffers(const std::shared_ptr<::arrow::ArrayData> &data,
+    std::unordered_map<const std::uint8_t *, std::int64_t> &buffers)
+{
+    for (auto buf : data->buffers) {
+        if (buf == nullptr) {
+            continue;
+        }
+
+        while (buf->parent() != nullptr) {
+            buf = buf->parent();
+        }
+
+        if (buf->data() != nullptr) {
+            buffers.emplace(buf->data(), buf->size());
+        }
+    }
+
+    for (auto &&child : data->child_data) {
+        collect_buffers(child, buffers);
+    }
+
+    if (data->type->id() == ::arrow::Type::DICTIONARY) {
+        collect_buffers(
+            ::arrow::DictionaryArray(data).dictionary()->data(), buffers);
+    }
+}
+
+} // namespace internal
+
+/// \brief Bytes used by an array, counting only the part of each buffer
+/// covered by the array when it is a slice
+inline std::size_t memory_usage(const ::arrow::Array &array)
+{
+    auto &data = array.data();
+
+    return static_cast<std::size_t>(
+        internal::slice_bytes(data, data->offset, data->length));
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_MEMORY_HPP
@@ -0,0 +1,243 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_PROMOTE_HPP
+#define DATAFRAME_ARRAY_PROMOTE_HPP
+
+#include <dataframe/array/cast.hpp>
+
+namespace dataframe {
+
+namespace internal {
+
+inline int integer_byte_width(const ::arrow::DataType &type)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type.id()) {
+        case ::arrow::Type::INT8:
+        case ::arrow::Type::UINT8:
+            return 1;
+        case ::arrow::Type::INT16:
+        case ::arrow::Type::UINT16:
+            return 2;
+        case ::arrow::Type::INT32:
+        case ::arrow::Type::UINT32:
+            return 4;
+        case ::arrow::Type::INT64:
+        case ::arrow::Type::UINT64:
+            return 8;
+        default:
+            return 0;
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+inline bool is_signed_integer(const ::arrow::DataType &type)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type.id()) {
+        case ::arrow::Type::INT8:
+        case ::arrow::Type::INT16:
+        case ::arrow::Type::INT32:
+        case ::arrow::Type::INT64:
+            return true;
+        default:
+            return false;
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+inline bool is_floating(const ::arrow::DataType &type)
+{
+    return type.id() == ::arrow::Type::FLOAT ||
+        type.id() == ::arrow::Type::DOUBLE;
+}
+
+inline std::shared_ptr<::arrow::DataType> make_integer_type(
+    bool is_signed, int byte_width)
+{
+    switch (byte_width) {
+        case 1:
+            return is_signed ? ::arrow::int8() : ::arrow::uint8();
+        case 2:
+            return is_signed ? ::arrow::int16() : ::arrow::uint16();
+        case 4:
+            return is_signed ? ::arrow::int32() : ::arrow::uint32();
+        case 8:
+            return is_signed ? ::arrow::int64() : ::arrow::uint64();
+        default:
+            return nullptr;
+    }
+}
+
+} // namespace internal
+
+/// \brief Find the narrowest type both `type1` and `type2` can be converted
+/// to
+///
+/// Integers of the same signedness are widened to the wider type, and
+/// integers of mixed signedness to the next wider signed integer, both
+/// losslessly. Mixing integers and floating point gives `float64`, which is
+/// exact only for integers no larger than 2^53 in magnitude
+///
+/// \return `nullptr` if there is no such type, e.g., for `int64` and
+/// `uint64`, or for dictionaries of different value types
+inline std::shared_ptr<::arrow::DataType> promote_type(
+    const std::shared_ptr<::arrow::DataType> &type1,
+    const std::shared_ptr<::arrow::DataType> &type2)
+{
+    if (type1->Equals(*type2)) {
+        return type1;
+    }
+
+    if (type1->id() == ::arrow::Type::NA) {
+        return type2;
+    }
+
+    if (type2->id() == ::arrow::Type::NA) {
+        return type1;
+    }
+
+    auto w1 = internal::integer_byte_width(*type1);
+    auto w2 = internal::integer_byte_width(*type2);
+
+    if (w1 != 0 && w2 != 0) {
+        auto s1 = internal::is_signed_integer(*type1);
+        auto s2 = internal::is_signed_integer(*type2);
+
+        if (s1 == s2) {
+            return w1 > w2 ? type1 : type2;
+        }
+
+        auto ws = s1 ? w1 : w2;
+        auto wu = s1 ? w2 : w1;
+
+        if (ws > wu) {
+            return s1 ? type1 : type2;
+        }
+
+        return internal::make_integer_type(true, wu * 2);
+    }
+
+    auto f1 = internal::is_floating(*type1);
+    auto f2 = internal::is_floating(*type2);
+
+    if ((f1 || w1 != 0) && (f2 || w2 != 0)) {
+        return ::arrow::float64();
+    }
+
+    if (type1->id() == ::arrow::Type::DICTIONARY &&
+        type2->id() == ::arrow::Type::DICTIONARY) {
+        auto &dict1 = static_cast<const ::arrow::DictionaryType &>(*type1);
+        auto &dict2 = static_cast<const ::arrow::DictionaryType &>(*type2);
+
+        if (!dict1.value_type()->Equals(*dict2.value_type())) {
+            return nullptr;
+        }
+
+        auto index =
+            promote_type(dict1.index_type(), dict2.index_type());
+        if (index == nullptr) {
+            return nullptr;
+        }
+
+        return ::arrow::dictionary(index, dict1.value_type(),
+            dict1.ordered() && dict2.ordered());
+    }
+
+    return nullptr;
+}
+
+/// \brief Convert an array to a type returned by `promote_type`
+inline std::shared_ptr<::arrow::Array> promote_array(
+    const std::shared_ptr<::arrow::Array> &array,
+    const std::shared_ptr<::arrow::DataType> &type,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    if (array->type()->Equals(*type)) {
+        return array;
+    }
+
+    if (array->type_id() == ::arrow::Type::NA) {
+        if (type->id() == ::arrow::Type::DICTIONARY) {
+            auto &dict = static_cast<const ::arrow::DictionaryType &>(*type);
+
+            std::shared_ptr<::arrow::Array> indices;
+            DF_ARROW_ERROR_HANDLER(::arrow::MakeArrayOfNull(
+                dict.index_type(), array->length(), &indices));
+
+            std::shared_ptr<::arrow::Array> dictionary;
+            DF_ARROW_ERROR_HANDLER(
+                ::arrow::MakeArrayOfNull(dict.value_type(), 0, &dictionary));
+
+            std::shared_ptr<::arrow::Array> ret;
+            DF_ARROW_ERROR_HANDLER(::arrow::DictionaryArray::FromArrays(
+                type, indices, dictionary, &ret));
+
+            return ret;
+        }
+
+        std::shared_ptr<::arrow::Array> ret;
+        DF_ARROW_ERROR_HANDLER(
+            ::arrow::MakeArrayOfNull(type, array->length(), &ret));
+
+        return ret;
+    }
+
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type->id()) {
+        case ::arrow::Type::INT8:
+            return cast_array<std::int8_t>(array, pool);
+        case ::arrow::Type::INT16:
+            return cast_array<std::int16_t>(array, pool);
+        case ::arrow::Type::INT32:
+            return cast_array<std::int32_t>(array, pool);
+        case ::arrow::Type::INT64:
+            return cast_array<std::int64_t>(array, pool);
+        case ::arrow::Type::UINT8:
+            return cast_array<std::uint8_t>(array, pool);
+        case ::arrow::Type::UINT16:
+            return cast_array<std::uint16_t>(array, pool);
+        case ::arrow::Type::UINT32:
+            return cast_array<std::uint32_t>(array, pool);
+        case ::arrow::Type::UINT64:
+            return cast_array<std::uint64_t>(array, pool);
+        case ::arrow::Type::FLOAT:
+            return cast_array<float>(array, pool);
+        case ::arrow::Type::DOUBLE:
+            return cast_array<double>(array, pool);
+        case ::arrow::Type::DICTIONARY: {
+            auto &dict = static_cast<const ::arrow::DictionaryArray &>(*array);
+            auto &dict_type =
+                static_cast<const ::arrow::DictionaryType &>(*type);
+
+            std::shared_ptr<::arrow::Array> ret;
+            DF_ARROW_ERROR_HANDLER(::arrow::DictionaryArray::FromArrays(type,
+                promote_array(dict.indices(), dict_type.index_type(), pool),
+                dict.dictionary(), &ret));
+
+            return ret;
+        }
+        default:
+            throw DataFrameException("Cannot promote array of type " +
+                array->type()->ToString() + " to " + type->ToString());
+    }
+    DF_DIAGNOSTIC_POP
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_PROMOTE_HPP
@@ -0,0 +1,265 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_RUNS_HPP
+#define DATAFRAME_ARRAY_RUNS_HPP
+
+#include <dataframe/array/make.hpp>
+#include <dataframe/array/repeat.hpp>
+#include <dataframe/array/select.hpp>
+#include <cstring>
+
+namespace dataframe {
+
+/// \brief Number of rows in the block of values shared by the chunks of a
+/// run, runs shorter than this are stored with their exact length
+constexpr std::int64_t run_block_size = 1 << 16;
+
+namespace internal {
+
+template <typename Equal>
+inline void find_runs(const ::arrow::Array &array, Equal &&equal,
+    std::vector<std::int64_t> *starts)
+{
+    auto n = array.length();
+    auto nulls = array.null_count() != 0;
+
+    if (n != 0) {
+        starts->push_back(0);
+    }
+
+    for (std::int64_t i = 1; i < n; ++i) {
+        auto null1 = nulls && array.IsNull(i - 1);
+        auto null2 = nulls && array.IsNull(i);
+        if (null1 != null2 || (!null2 && !equal(i - 1, i))) {
+            starts->push_back(i);
+        }
+    }
+}
+
+/// \brief Positions where a new run of equal values starts
+inline std::vector<std::int64_t> find_runs(const ::arrow::Array &array)
+{
+    std::vector<std::int64_t> ret;
+
+    auto &data = *array.data();
+    auto &type = *array.type();
+
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (type.id()) {
+        case ::arrow::Type::NA:
+            if (array.length() != 0) {
+                ret.push_back(0);
+            }
+            break;
+        case ::arrow::Type::BOOL: {
+            auto &values = static_cast<const ::arrow::BooleanArray &>(array);
+            find_runs(array,
+                [&](auto i, auto j) {
+                    return values.Value(i) == values.Value(j);
+                },
+                &ret);
+        } break;
+        case ::arrow::Type::UINT8:
+        case ::arrow::Type::INT8:
+        case ::arrow::Type::UINT16:
+        case ::arrow::Type::INT16:
+        case ::arrow::Type::UINT32:
+        case ::arrow::Type::INT32:
+        case ::arrow::Type::UINT64:
+        case ::arrow::Type::INT64:
+        case ::arrow::Type::HALF_FLOAT:
+        case ::arrow::Type::FLOAT:
+        case ::arrow::Type::DOUBLE:
+        case ::arrow::Type::DATE32:
+        case ::arrow::Type::DATE64:
+        case ::arrow::Type::TIMESTAMP:
+        case ::arrow::Type::TIME32:
+        case ::arrow::Type::TIME64:
+        case ::arrow::Type::FIXED_SIZE_BINARY:
+        case ::arrow::Type::DECIMAL: {
+            // Bitwise equality, so equal NaNs share a run
+            auto width = static_cast<const ::arrow::FixedWidthType &>(type)
+                             .bit_width() /
+                8;
+            auto values = data.buffers.at(1)->data() + data.offset * width;
+            auto bytes = static_cast<std::size_t>(width);
+            find_runs(array,
+                [&](auto i, auto j) {
+                    return std::memcmp(values + i * width,
+                               values + j * width, bytes) == 0;
+                },
+                &ret);
+        } break;
+        case ::arrow::Type::STRING:
+        case ::arrow::Type::BINARY: {
+            auto &values = static_cast<const ::arrow::BinaryArray &>(array);
+            find_runs(array,
+                [&](auto i, auto j) {
+                    std::int32_t n1 = 0;
+                    std::int32_t n2 = 0;
+                    auto v1 = values.GetValue(i, &n1);
+                    auto v2 = values.GetValue(j, &n2);
+                    return n1 == n2 &&
+                        std::memcmp(v1, v2, static_cast<std::size_t>(n1)) ==
+                        0;
+                },
+                &ret);
+        } break;
+        case ::arrow::Type::DICTIONARY: {
+            // Nulls are recorded in the indices as well
+            auto &dict = static_cast<const ::arrow::DictionaryArray &>(array);
+            ret = find_runs(*dict.indices());
+        } break;
+        default:
+            find_runs(array,
+                [&](auto i, auto j) {
+                    return array.RangeEquals(array, i, i + 1, j);
+                },
+                &ret);
+            break;
+    }
+    DF_DIAGNOSTIC_POP
+
+    return ret;
+}
+
+/// \brief Append chunks of `length` rows sharing the buffers of `block`
+inline void append_run(const std::shared_ptr<::arrow::Array> &block,
+    std::int64_t length, ::arrow::ArrayVector *chunks)
+{
+    auto size = block->length();
+    for (std::int64_t offset = 0; offset < length; offset += size) {
+        auto len = std::min(size, length - offset);
+        chunks->push_back(len == size ? block : block->Slice(0, len));
+    }
+}
+
+} // namespace internal
+
+/// \brief A chunked array with `length` copies of `value`, all chunks share a
+/// block of at most `block_size` values
+template <typename T>
+inline std::shared_ptr<::arrow::ChunkedArray> constant_array(const T &value,
+    std::int64_t length, std::int64_t block_size = run_block_size,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    if (block_size <= 0) {
+        throw DataFrameException("Block size must be positive");
+    }
+
+    auto rep = repeat(
+        value, static_cast<std::size_t>(std::min(length, block_size)));
+    auto block = make_array<T>(rep.begin(), rep.end(), pool);
+
+    ::arrow::ArrayVector chunks;
+    internal::append_run(block, length, &chunks);
+
+    return std::make_shared<::arrow::ChunkedArray>(chunks, block->type());
+}
+
+/// \brief Encode runs of equal values, each run is a sequence of chunks that
+/// share a block of at most `block_size` copies of its value
+///
+/// Returns nullptr if there are more than `max_runs` runs, or if no run is
+/// longer than `block_size`, in which case the encoding would not save
+/// memory
+inline std::shared_ptr<::arrow::ChunkedArray> encode_runs(
+    const ::arrow::ArrayVector &chunks, std::size_t max_runs = 1024,
+    std::int64_t block_size = run_block_size,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    if (chunks.empty()) {
+        throw DataFrameException("Cannot encode runs of empty chunks");
+    }
+
+    if (block_size <= 0) {
+        throw DataFrameException("Block size must be positive");
+    }
+
+    struct Run {
+        std::size_t chunk;
+        std::int64_t start;
+        std::int64_t length;
+    };
+
+    std::vector<Run> runs;
+    std::shared_ptr<::arrow::Array> prev;
+    for (std::size_t k = 0; k != chunks.size(); ++k) {
+        auto &chunk = chunks[k];
+        auto starts = internal::find_runs(*chunk);
+        auto n = chunk->length();
+
+        for (std::size_t i = 0; i != starts.size(); ++i) {
+            auto start = starts[i];
+            auto end = i + 1 == starts.size() ? n : starts[i + 1];
+
+            // A run may continue from the previous chunk
+            if (start == 0 && prev != nullptr && !runs.empty() &&
+                chunk->RangeEquals(*prev, 0, 1, prev->length() - 1)) {
+                runs.back().length += end;
+            } else {
+                runs.push_back(Run{k, start, end - start});
+            }
+
+            if (runs.size() > max_runs) {
+                return nullptr;
+            }
+        }
+
+        if (n != 0) {
+            prev = chunk;
+        }
+    }
+
+    std::int64_t nrow = 0;
+    std::int64_t stored = 0;
+    for (auto &run : runs) {
+        nrow += run.length;
+        stored += std::min(run.length, block_size);
+    }
+
+    if (stored == nrow) {
+        return nullptr;
+    }
+
+    ::arrow::ArrayVector ret;
+    for (auto &run : runs) {
+        auto &chunk = chunks[run.chunk];
+        auto size = std::min(run.length, block_size);
+        std::vector<std::int64_t> index(static_cast<std::size_t>(size),
+            chunk->IsNull(run.start) ? -1 : run.start);
+        internal::append_run(
+            select_array(chunk, index.begin(), index.end(), pool), run.length,
+            &ret);
+    }
+
+    return std::make_shared<::arrow::ChunkedArray>(
+        ret, chunks.front()->type());
+}
+
+inline std::shared_ptr<::arrow::ChunkedArray> encode_runs(
+    const std::shared_ptr<::arrow::Array> &array, std::size_t max_runs = 1024,
+    std::int64_t block_size = run_block_size,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    return encode_runs(
+        ::arrow::ArrayVector{array}, max_runs, block_size, pool);
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_RUNS_HPP
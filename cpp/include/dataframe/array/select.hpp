@@ -17,31 +17,40 @@
 #ifndef DATAFRAME_ARRAY_SELECT_HPP
 #define DATAFRAME_ARRAY_SELECT_HPP
 
+#include <dataframe/array/bind.hpp>
 #include <dataframe/array/make.hpp>
 #include <dataframe/array/view.hpp>
+#include <algorithm>
+#include <cstring>
 
 namespace dataframe {
 
 template <typename Iter>
 std::shared_ptr<::arrow::Array> select_array(
-    const std::shared_ptr<::arrow::Array> &array, Iter first, Iter last);
+    const std::shared_ptr<::arrow::Array> &array, Iter first, Iter last,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool());
+
+template <typename Iter>
+std::shared_ptr<::arrow::Array> select_array(
+    const ::arrow::ArrayVector &chunks, Iter first, Iter last,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool());
 
 namespace internal {
 
-template <typename T, typename Iter>
+template <typename View, typename Iter>
 class SelectIterator
 {
   public:
-    using value_type = typename ArrayView<T>::value_type;
+    using value_type = typename View::value_type;
 
-    using reference = std::conditional_t<
-        std::is_reference_v<typename ArrayView<T>::reference>,
-        typename ArrayView<T>::value_type, typename ArrayView<T>::reference>;
+    using reference =
+        std::conditional_t<std::is_reference_v<typename View::reference>,
+            typename View::value_type, typename View::reference>;
 
     using iterator_category =
         typename std::iterator_traits<Iter>::iterator_category;
 
-    SelectIterator(const ArrayView<T> &view, Iter iter)
+    SelectIterator(const View &view, Iter iter)
         : view_(view)
         , iter_(iter)
     {
@@ -61,173 +70,207 @@ class SelectIterator
     DF_DEFINE_ITERATOR_MEMBERS(SelectIterator, iter_)
 
   private:
-    const ArrayView<T> &view_;
+    const View &view_;
     Iter iter_;
 };
 
 template <typename Iter>
-struct SelectVisitor : ::arrow::ArrayVisitor {
-    std::shared_ptr<::arrow::Array> values;
+struct SelectVisitor {
+    ::arrow::ArrayVector chunks;
     std::shared_ptr<::arrow::Array> result;
     Iter first;
     Iter last;
-    std::int64_t length;
+    ::arrow::MemoryPool *pool;
 
-    SelectVisitor(std::shared_ptr<::arrow::Array> v, Iter f, Iter l)
-        : values(std::move(v))
+    SelectVisitor(
+        ::arrow::ArrayVector c, Iter f, Iter l, ::arrow::MemoryPool *p)
+        : chunks(std::move(c))
         , first(f)
         , last(l)
+        , pool(p)
     {
     }
 
-    ::arrow::Status Visit(const ::arrow::NullArray &) override
+    template <typename T>
+    ::arrow::Status select()
     {
-        result = std::make_shared<::arrow::NullArray>(
-            static_cast<std::int64_t>(std::distance(first, last)));
+        if (chunks.size() == 1) {
+            using I = SelectIterator<ArrayView<T>, Iter>;
+            auto view = make_view<T>(chunks.front());
+            result = make_array<T>(I(view, first), I(view, last), pool);
+        } else {
+            using I = SelectIterator<ChunkedArrayView<T>, Iter>;
+            auto view = make_view<T>(chunks);
+            result = make_array<T>(I(view, first), I(view, last), pool);
+        }
 
         return ::arrow::Status::OK();
     }
 
-#define DF_DEFINE_VISITOR(Arrow, T)                                           \
-    ::arrow::Status Visit(const ::arrow::Arrow##Array &) override             \
-    {                                                                         \
-        using I = SelectIterator<T, Iter>;                                    \
-        auto view = make_view<T>(values);                                     \
-        result = make_array<T>(I(view, first), I(view, last));                \
-                                                                              \
-        return ::arrow::Status::OK();                                         \
-    }
-
-    DF_DEFINE_VISITOR(Boolean, bool)
-    DF_DEFINE_VISITOR(Int8, std::int8_t)
-    DF_DEFINE_VISITOR(Int16, std::int16_t)
-    DF_DEFINE_VISITOR(Int32, std::int32_t)
-    DF_DEFINE_VISITOR(Int64, std::int64_t)
-    DF_DEFINE_VISITOR(UInt8, std::uint8_t)
-    DF_DEFINE_VISITOR(UInt16, std::uint16_t)
-    DF_DEFINE_VISITOR(UInt32, std::uint32_t)
-    DF_DEFINE_VISITOR(UInt64, std::uint64_t)
-    DF_DEFINE_VISITOR(Float, float)
-    DF_DEFINE_VISITOR(Double, double)
-    DF_DEFINE_VISITOR(String, std::string)
-    DF_DEFINE_VISITOR(Binary, std::string)
-    DF_DEFINE_VISITOR(Date32, Datestamp<DateUnit::Day>)
-    DF_DEFINE_VISITOR(Date64, Datestamp<DateUnit::Millisecond>)
-
-#undef DF_DEFINE_VISITOR
-
-    // DF_DFINE_VISITOR(HalfFloatArray &);
-    // DF_DFINE_VISITOR(FixedSizeBinaryArray &);
-
-    ::arrow::Status Visit(const ::arrow::Time32Array &array) override
+    template <typename ArrowType>
+    ::arrow::TimeUnit::type unit() const
     {
-        auto type =
-            std::static_pointer_cast<::arrow::Time32Type>(array.type());
-
-        switch (type->unit()) {
-            case ::arrow::TimeUnit::SECOND: {
-                using T = Time<TimeUnit::Second>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
-            case ::arrow::TimeUnit::MILLI: {
-                using T = Time<TimeUnit::Millisecond>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
-            case ::arrow::TimeUnit::MICRO:
-                throw DataFrameException("Unexpected Time32 unit");
-            case ::arrow::TimeUnit::NANO:
-                throw DataFrameException("Unexpected Time32 unit");
-        }
-
-        return ::arrow::Status::OK();
+        return static_cast<const ArrowType &>(*chunks.front()->type()).unit();
     }
 
-    ::arrow::Status Visit(const ::arrow::Time64Array &array) override
+    /// \brief Gather values of types without a value type of their own, such
+    /// as half floats and fixed size binaries, as raw bytes
+    ::arrow::Status select_bytes()
     {
-        auto type =
-            std::static_pointer_cast<::arrow::Time64Type>(array.type());
-
-        switch (type->unit()) {
-            case ::arrow::TimeUnit::SECOND:
-                throw DataFrameException("Unexpected Time64 unit");
-            case ::arrow::TimeUnit::MILLI:
-                throw DataFrameException("Unexpected Time64 unit");
-            case ::arrow::TimeUnit::MICRO: {
-                using T = Time<TimeUnit::Microsecond>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
-            case ::arrow::TimeUnit::NANO: {
-                using T = Time<TimeUnit::Nanosecond>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
+        auto &type = chunks.front()->type();
+        auto width = static_cast<const ::arrow::FixedWidthType &>(*type)
+                         .bit_width() /
+            8;
+
+        std::vector<std::int64_t> offsets;
+        offsets.reserve(chunks.size() + 1);
+        offsets.push_back(0);
+        for (auto &&chunk : chunks) {
+            offsets.push_back(offsets.back() + chunk->length());
         }
 
-        return ::arrow::Status::OK();
-    }
-
-    ::arrow::Status Visit(const ::arrow::TimestampArray &array) override
-    {
-        auto type =
-            std::static_pointer_cast<::arrow::TimestampType>(array.type());
-
-        switch (type->unit()) {
-            case ::arrow::TimeUnit::SECOND: {
-                using T = Timestamp<TimeUnit::Second>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
-            case ::arrow::TimeUnit::MILLI: {
-                using T = Timestamp<TimeUnit::Millisecond>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
-            case ::arrow::TimeUnit::MICRO: {
-                using T = Timestamp<TimeUnit::Microsecond>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
-            case ::arrow::TimeUnit::NANO: {
-                using T = Timestamp<TimeUnit::Nanosecond>;
-                using I = SelectIterator<T, Iter>;
-                auto view = make_view<T>(values);
-                result = make_array<T>(I(view, first), I(view, last));
-            } break;
+        auto n = static_cast<std::int64_t>(std::distance(first, last));
+
+        std::shared_ptr<::arrow::Buffer> values;
+        ARROW_RETURN_NOT_OK(::arrow::AllocateBuffer(pool, n * width, &values));
+        auto dst =
+            dynamic_cast<::arrow::MutableBuffer &>(*values).mutable_data();
+        auto w = static_cast<std::size_t>(width);
+
+        for (auto iter = first; iter != last; ++iter, dst += width) {
+            auto idx = static_cast<std::int64_t>(*iter);
+            if (idx < 0) {
+                std::memset(dst, 0, w);
+                continue;
+            }
+
+            auto k = static_cast<std::size_t>(
+                std::upper_bound(offsets.begin(), offsets.end(), idx) -
+                offsets.begin() - 1);
+            auto &data = *chunks[k]->data();
+            auto src = data.buffers[1]->data() +
+                (data.offset + idx - offsets[k]) * width;
+            std::memcpy(dst, src, w);
         }
 
+        result = ::arrow::MakeArray(
+            ::arrow::ArrayData::Make(type, n, {nullptr, std::move(values)}));
+
         return ::arrow::Status::OK();
     }
 
-    ::arrow::Status Visit(const ::arrow::DictionaryArray &array) override
+    template <typename ArrowType>
+    ::arrow::Status operator()(TypeTag<ArrowType>)
     {
-        auto index = select_array(array.indices(), first, last);
-
-        return ::arrow::DictionaryArray::FromArrays(
-            array.type(), index, array.dictionary(), &result);
+        constexpr bool is_number = std::is_base_of_v<::arrow::NumberType,
+                                       ArrowType> &&
+            !std::is_same_v<ArrowType, ::arrow::HalfFloatType>;
+
+        if constexpr (std::is_same_v<ArrowType, ::arrow::NullType>) {
+            result = std::make_shared<::arrow::NullArray>(
+                static_cast<std::int64_t>(std::distance(first, last)));
+
+            return ::arrow::Status::OK();
+        } else if constexpr (std::is_same_v<ArrowType,
+                                 ::arrow::BooleanType>) {
+            return select<bool>();
+        } else if constexpr (is_number) {
+            return select<typename ArrowType::c_type>();
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::StringType> ||
+            std::is_same_v<ArrowType, ::arrow::BinaryType>) {
+            return select<std::string>();
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::Date32Type>) {
+            return select<Datestamp<DateUnit::Day>>();
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::Date64Type>) {
+            return select<Datestamp<DateUnit::Millisecond>>();
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::Time32Type>) {
+            switch (unit<ArrowType>()) {
+                case ::arrow::TimeUnit::SECOND:
+                    return select<Time<TimeUnit::Second>>();
+                case ::arrow::TimeUnit::MILLI:
+                    return select<Time<TimeUnit::Millisecond>>();
+                case ::arrow::TimeUnit::MICRO:
+                case ::arrow::TimeUnit::NANO:
+                    break;
+            }
+
+            return ::arrow::Status::Invalid("Unexpected Time32 unit");
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::Time64Type>) {
+            switch (unit<ArrowType>()) {
+                case ::arrow::TimeUnit::SECOND:
+                case ::arrow::TimeUnit::MILLI:
+                    break;
+                case ::arrow::TimeUnit::MICRO:
+                    return select<Time<TimeUnit::Microsecond>>();
+                case ::arrow::TimeUnit::NANO:
+                    return select<Time<TimeUnit::Nanosecond>>();
+            }
+
+            return ::arrow::Status::Invalid("Unexpected Time64 unit");
+        } else if constexpr (std::is_same_v<ArrowType,
+                                 ::arrow::TimestampType>) {
+            switch (unit<ArrowType>()) {
+                case ::arrow::TimeUnit::SECOND:
+                    return select<Timestamp<TimeUnit::Second>>();
+                case ::arrow::TimeUnit::MILLI:
+                    return select<Timestamp<TimeUnit::Millisecond>>();
+                case ::arrow::TimeUnit::MICRO:
+                    return select<Timestamp<TimeUnit::Microsecond>>();
+                case ::arrow::TimeUnit::NANO:
+                    return select<Timestamp<TimeUnit::Nanosecond>>();
+            }
+
+            return ::arrow::Status::Invalid("Unexpected Timestamp unit");
+        } else if constexpr (std::is_same_v<ArrowType,
+                                 ::arrow::DictionaryType>) {
+            // Chunks may carry different dictionaries, unify them first
+            auto values = chunks.size() == 1 ? chunks.front() :
+                                               bind_array(chunks, pool);
+
+            auto &dict =
+                static_cast<const ::arrow::DictionaryArray &>(*values);
+            auto index = select_array(dict.indices(), first, last, pool);
+
+            return ::arrow::DictionaryArray::FromArrays(
+                values->type(), index, dict.dictionary(), &result);
+        } else if constexpr (std::is_base_of_v<::arrow::FixedWidthType,
+                                 ArrowType>) {
+            return select_bytes();
+        } else {
+            return ::arrow::Status::NotImplemented(
+                "Cannot select from ", chunks.front()->type()->ToString());
+        }
     }
 };
 
 } // namespace internal
 
+/// \brief Select elements from an array by index, a negative index selects a
+/// null value
+template <typename Iter>
+std::shared_ptr<::arrow::Array> select_array(
+    const std::shared_ptr<::arrow::Array> &array, Iter first, Iter last,
+    ::arrow::MemoryPool *pool)
+{
+    return select_array(::arrow::ArrayVector{array}, first, last, pool);
+}
+
+/// \brief Select elements from a chunked array by index into the logical
+/// concatenation of the chunks, without combining them first
 template <typename Iter>
 std::shared_ptr<::arrow::Array> select_array(
-    const std::shared_ptr<::arrow::Array> &array, Iter first, Iter last)
+    const ::arrow::ArrayVector &chunks, Iter first, Iter last,
+    ::arrow::MemoryPool *pool)
 {
-    internal::SelectVisitor<Iter> visitor(array, first, last);
-    DF_ARROW_ERROR_HANDLER(array->Accept(&visitor));
+    if (chunks.empty()) {
+        throw DataFrameException("Cannot select from empty chunks");
+    }
+
+    internal::SelectVisitor<Iter> visitor(chunks, first, last, pool);
+    DF_ARROW_ERROR_HANDLER(visit_type(chunks.front()->type_id(), visitor));
 
     std::vector<bool> valid;
-    bool null_count = 0;
+    std::int64_t null_count = 0;
     for (auto iter = first; iter != last; ++iter) {
         auto is_valid = *iter >= 0;
         valid.push_back(is_valid);
@@ -235,7 +278,8 @@ std::shared_ptr<::arrow::Array> select_array(
     }
 
     return null_count == 0 ? visitor.result :
-                             internal::set_mask(visitor.result, valid.begin());
+                             internal::set_mask(
+                                 visitor.result, valid.begin(), pool);
 }
 
 } // namespace dataframe
@@ -0,0 +1,496 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_STATS_HPP
+#define DATAFRAME_ARRAY_STATS_HPP
+
+#include <dataframe/array/type.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+namespace dataframe {
+
+/// \brief Summary statistics of a column
+///
+/// Integer, date and time values are recorded as `std::int64_t` or
+/// `std::uint64_t`, floating point values as `double` and string or binary
+/// values as `std::string`. Other types only record the counts
+struct ColumnStats {
+    using value_type = std::variant<std::monostate, std::int64_t,
+        std::uint64_t, double, std::string>;
+
+    std::size_t length = 0;
+
+    std::size_t null_count = 0;
+
+    /// \brief Number of NaN values, which are left out of `min`, `max` and
+    /// `sorted` since they compare unordered with all values
+    std::size_t nan_count = 0;
+
+    /// \brief The smallest non-null value, monostate if there is none
+    value_type min;
+
+    /// \brief The largest non-null value, monostate if there is none
+    value_type max;
+
+    /// \brief Whether the non-null values other than NaN are in
+    /// non-decreasing order
+    bool sorted = false;
+
+    /// \brief Approximate number of distinct non-null values
+    std::size_t ndv = 0;
+};
+
+inline bool operator==(const ColumnStats &s1, const ColumnStats &s2)
+{
+    return s1.length == s2.length && s1.null_count == s2.null_count &&
+        s1.nan_count == s2.nan_count && s1.min == s2.min &&
+        s1.max == s2.max && s1.sorted == s2.sorted && s1.ndv == s2.ndv;
+}
+
+inline bool operator!=(const ColumnStats &s1, const ColumnStats &s2)
+{
+    return !(s1 == s2);
+}
+
+namespace internal {
+
+/// \brief HyperLogLog distinct count estimate with 4096 registers, the
+/// standard error is about 1.6%
+class HyperLogLog
+{
+  public:
+    HyperLogLog() { registers_.fill(0); }
+
+    void add(std::uint64_t hash)
+    {
+        // Finalizer of MurmurHash3, std::hash is often the identity
+        hash ^= hash >> 33;
+        hash *= UINT64_C(0xff51afd7ed558ccd);
+        hash ^= hash >> 33;
+        hash *= UINT64_C(0xc4ceb9fe1a85ec53);
+        hash ^= hash >> 33;
+
+        auto index = static_cast<std::size_t>(hash >> (64 - bits));
+        auto rest = (hash << bits) | (UINT64_C(1) << (bits - 1));
+
+        std::uint8_t rank = 1;
+        while ((rest & (UINT64_C(1) << 63)) == 0) {
+            rest <<= 1;
+            ++rank;
+        }
+
+        registers_[index] = std::max(registers_[index], rank);
+    }
+
+    std::size_t estimate() const
+    {
+        constexpr double m = nregisters;
+        constexpr double alpha = 0.7213 / (1 + 1.079 / m);
+
+        double sum = 0;
+        std::size_t zeros = 0;
+        for (auto r : registers_) {
+            sum += std::ldexp(1.0, -r);
+            zeros += r == 0;
+        }
+
+        auto est = alpha * m * m / sum;
+
+        // Linear counting for small cardinalities
+        if (est <= 2.5 * m && zeros != 0) {
+            est = m * std::log(m / static_cast<double>(zeros));
+        }
+
+        return static_cast<std::size_t>(std::llround(est));
+    }
+
+  private:
+    static constexpr int bits = 12;
+    static constexpr std::size_t nregisters = std::size_t(1) << bits;
+
+    std::array<std::uint8_t, nregisters> registers_;
+};
+
+class StatsVisitor : public ::arrow::ArrayVisitor
+{
+  public:
+    ColumnStats stats;
+
+    explicit StatsVisitor(const ::arrow::ArrayVector &chunks)
+        : chunks_(chunks)
+    {
+        for (auto &&chunk : chunks_) {
+            stats.length += static_cast<std::size_t>(chunk->length());
+            stats.null_count += static_cast<std::size_t>(chunk->null_count());
+        }
+    }
+
+#define DF_DEFINE_VISITOR(Arrow, T)                                           \
+    ::arrow::Status Visit(const ::arrow::Arrow##Array &) override             \
+    {                                                                         \
+        visit_primitive<::arrow::Arrow##Array, T>();                          \
+                                                                              \
+        return ::arrow::Status::OK();                                         \
+    }
+
+    DF_DEFINE_VISITOR(Int8, std::int64_t)
+    DF_DEFINE_VISITOR(Int16, std::int64_t)
+    DF_DEFINE_VISITOR(Int32, std::int64_t)
+    DF_DEFINE_VISITOR(Int64, std::int64_t)
+    DF_DEFINE_VISITOR(UInt8, std::uint64_t)
+    DF_DEFINE_VISITOR(UInt16, std::uint64_t)
+    DF_DEFINE_VISITOR(UInt32, std::uint64_t)
+    DF_DEFINE_VISITOR(UInt64, std::uint64_t)
+    DF_DEFINE_VISITOR(Float, double)
+    DF_DEFINE_VISITOR(Double, double)
+    DF_DEFINE_VISITOR(Date32, std::int64_t)
+    DF_DEFINE_VISITOR(Date64, std::int64_t)
+    DF_DEFINE_VISITOR(Time32, std::int64_t)
+    DF_DEFINE_VISITOR(Time64, std::int64_t)
+    DF_DEFINE_VISITOR(Timestamp, std::int64_t)
+
+#undef DF_DEFINE_VISITOR
+
+    ::arrow::Status Visit(const ::arrow::BooleanArray &) override
+    {
+        return visit<::arrow::BooleanArray>([](auto &&array, auto i) {
+            return static_cast<std::int64_t>(array.Value(i));
+        });
+    }
+
+    ::arrow::Status Visit(const ::arrow::StringArray &) override
+    {
+        return visit_binary<::arrow::StringArray>();
+    }
+
+    ::arrow::Status Visit(const ::arrow::BinaryArray &) override
+    {
+        return visit_binary<::arrow::BinaryArray>();
+    }
+
+  private:
+    static std::uint64_t hash(std::int64_t v)
+    {
+        return static_cast<std::uint64_t>(v);
+    }
+
+    static std::uint64_t hash(std::uint64_t v) { return v; }
+
+    static std::uint64_t hash(double v)
+    {
+        std::uint64_t ret = 0;
+        v = v == 0 ? 0.0 : v;
+        std::memcpy(&ret, &v, sizeof(v));
+
+        return ret;
+    }
+
+    static std::uint64_t hash(std::string_view v)
+    {
+        return static_cast<std::uint64_t>(std::hash<std::string_view>()(v));
+    }
+
+    // Null-free chunks take reduction loops over the raw values the compiler
+    // can vectorize
+    template <typename ArrayType, typename T>
+    void visit_primitive()
+    {
+        bool has_value = false;
+        T minval = T();
+        T maxval = T();
+        T last = T();
+        bool sorted = true;
+        HyperLogLog hll;
+
+        for (auto &&chunk : chunks_) {
+            auto &array = static_cast<const ArrayType &>(*chunk);
+            auto n = array.length();
+            auto v = array.raw_values();
+
+            std::int64_t nans = 0;
+            if constexpr (std::is_floating_point_v<T>) {
+                for (std::int64_t i = 0; i != n; ++i) {
+                    nans += v[i] != v[i];
+                }
+            }
+
+            if (array.null_count() != 0 || nans != 0) {
+                for (std::int64_t i = 0; i != n; ++i) {
+                    if (array.IsNull(i)) {
+                        continue;
+                    }
+                    auto x = static_cast<T>(v[i]);
+                    hll.add(hash(x));
+                    if (x != x) {
+                        ++stats.nan_count;
+                        continue;
+                    }
+                    if (!has_value) {
+                        minval = maxval = last = x;
+                        has_value = true;
+                    }
+                    minval = std::min(minval, x);
+                    maxval = std::max(maxval, x);
+                    sorted = sorted && !(x < last);
+                    last = x;
+                }
+                continue;
+            }
+
+            if (n == 0) {
+                continue;
+            }
+
+            auto lo = v[0];
+            auto hi = v[0];
+            for (std::int64_t i = 1; i < n; ++i) {
+                lo = std::min(lo, v[i]);
+                hi = std::max(hi, v[i]);
+            }
+
+            if (sorted) {
+                sorted = !has_value || !(static_cast<T>(v[0]) < last);
+                for (std::int64_t i = 1; sorted && i < n; ++i) {
+                    sorted = !(v[i] < v[i - 1]);
+                }
+            }
+
+            for (std::int64_t i = 0; i != n; ++i) {
+                hll.add(hash(static_cast<T>(v[i])));
+            }
+
+            if (!has_value) {
+                minval = static_cast<T>(lo);
+                maxval = static_cast<T>(hi);
+                has_value = true;
+            }
+            minval = std::min(minval, static_cast<T>(lo));
+            maxval = std::max(maxval, static_cast<T>(hi));
+            last = static_cast<T>(v[n - 1]);
+        }
+
+        finish(has_value, minval, maxval, sorted, hll);
+    }
+
+    template <typename ArrayType>
+    ::arrow::Status visit_binary()
+    {
+        return visit<ArrayType>([](auto &&array, auto i) {
+            auto v = array.GetView(i);
+            return std::string_view(v.data(), v.size());
+        });
+    }
+
+    template <typename ArrayType, typename Get>
+    ::arrow::Status visit(Get &&get)
+    {
+        using T = std::decay_t<decltype(
+            get(std::declval<const ArrayType &>(), std::int64_t()))>;
+
+        bool has_value = false;
+        T minval = T();
+        T maxval = T();
+        T last = T();
+        bool sorted = true;
+        HyperLogLog hll;
+
+        for (auto &&chunk : chunks_) {
+            auto &array = static_cast<const ArrayType &>(*chunk);
+            auto n = array.length();
+            for (std::int64_t i = 0; i != n; ++i) {
+                if (array.IsNull(i)) {
+                    continue;
+                }
+                auto x = get(array, i);
+                if (!has_value) {
+                    minval = maxval = last = x;
+                    has_value = true;
+                }
+                minval = std::min(minval, x);
+                maxval = std::max(maxval, x);
+                sorted = sorted && !(x < last);
+                last = x;
+                hll.add(hash(x));
+            }
+        }
+
+        finish(has_value, minval, maxval, sorted, hll);
+
+        return ::arrow::Status::OK();
+    }
+
+    template <typename T>
+    void finish(bool has_value, const T &minval, const T &maxval, bool sorted,
+        const HyperLogLog &hll)
+    {
+        using V = std::conditional_t<std::is_same_v<T, std::string_view>,
+            std::string, T>;
+
+        stats.sorted = sorted;
+        if (has_value) {
+            stats.min = V(minval);
+            stats.max = V(maxval);
+            stats.ndv = hll.estimate();
+        }
+    }
+
+  private:
+    const ::arrow::ArrayVector &chunks_;
+};
+
+/// \brief Process wide cache of column statistics, keyed on the identity of
+/// the array data so that assigning a column gives fresh statistics
+class StatsCache
+{
+  public:
+    static StatsCache &instance()
+    {
+        static StatsCache cache;
+
+        return cache;
+    }
+
+    std::shared_ptr<const ColumnStats> find(
+        const std::shared_ptr<const void> &key) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto iter = stats_.find(key);
+
+        return iter == stats_.end() ? nullptr : iter->second;
+    }
+
+    void insert(const std::shared_ptr<const void> &key,
+        std::shared_ptr<const ColumnStats> stats)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        stats_[key] = std::move(stats);
+
+        // Drop the entries of released data once the cache doubles in size
+        if (stats_.size() >= prune_size_) {
+            for (auto iter = stats_.begin(); iter != stats_.end();) {
+                if (iter->first.expired()) {
+                    iter = stats_.erase(iter);
+                } else {
+                    ++iter;
+                }
+            }
+            prune_size_ = std::max(prune_size_, 2 * stats_.size());
+        }
+    }
+
+  private:
+    StatsCache() = default;
+
+    mutable std::mutex mutex_;
+    std::map<std::weak_ptr<const void>, std::shared_ptr<const ColumnStats>,
+        std::owner_less<std::weak_ptr<const void>>>
+        stats_;
+    std::size_t prune_size_ = 64;
+};
+
+/// \brief Compare a recorded value with an arithmetic value, integers are
+/// compared exactly
+///
+/// \return Negative, zero or positive if `value` is less than, equal to or
+/// greater than `x`, or `std::nullopt` if they cannot be compared
+template <typename T>
+inline std::optional<int> compare_stats_value(
+    const ColumnStats::value_type &value, T x)
+{
+    static_assert(std::is_arithmetic_v<T>);
+
+    return std::visit(
+        [x](auto &&v) -> std::optional<int> {
+            using V = std::decay_t<decltype(v)>;
+
+            if constexpr (!std::is_arithmetic_v<V>) {
+                return std::nullopt;
+            } else if constexpr (std::is_integral_v<V> &&
+                std::is_integral_v<T>) {
+                if constexpr (std::is_signed_v<V> && !std::is_signed_v<T>) {
+                    if (v < 0) {
+                        return -1;
+                    }
+                } else if constexpr (!std::is_signed_v<V> &&
+                    std::is_signed_v<T>) {
+                    if (x < 0) {
+                        return 1;
+                    }
+                }
+
+                // Both are non-negative if their signedness differ
+                using C = std::conditional_t<std::is_signed_v<V> &&
+                        std::is_signed_v<T>,
+                    std::int64_t, std::uint64_t>;
+                auto a = static_cast<C>(v);
+                auto b = static_cast<C>(x);
+
+                return a < b ? -1 : (b < a ? 1 : 0);
+            } else {
+                auto a = static_cast<double>(v);
+                auto b = static_cast<double>(x);
+                if (std::isnan(a) || std::isnan(b)) {
+                    return std::nullopt;
+                }
+
+                return a < b ? -1 : (b < a ? 1 : 0);
+            }
+        },
+        value);
+}
+
+} // namespace internal
+
+/// \brief Compute the statistics of the logical concatenation of chunks in
+/// one pass
+inline ColumnStats compute_stats(const ::arrow::ArrayVector &chunks)
+{
+    if (chunks.empty()) {
+        ColumnStats ret;
+        ret.sorted = true;
+
+        return ret;
+    }
+
+    // Types without an order only have their counts recorded
+    internal::StatsVisitor visitor(chunks);
+    auto status = chunks.front()->Accept(&visitor);
+    if (!status.IsNotImplemented()) {
+        DF_ARROW_ERROR_HANDLER(status);
+    }
+
+    return visitor.stats;
+}
+
+inline ColumnStats compute_stats(const std::shared_ptr<::arrow::Array> &array)
+{
+    return compute_stats(::arrow::ArrayVector{array});
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_STATS_HPP
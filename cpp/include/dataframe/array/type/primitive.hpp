@@ -17,6 +17,7 @@
 #ifndef DATAFRAME_ARRAY_TYPE_PRIMITIVE_HPP
 #define DATAFRAME_ARRAY_TYPE_PRIMITIVE_HPP
 
+#include <dataframe/array/type/visit.hpp>
 #include <dataframe/error.hpp>
 #include <arrow/api.h>
 
@@ -96,51 +97,14 @@ DF_DEFINE_TYPE_TRAITS(Double)
 
 #undef DF_DEFINE_TYPE_TRAITS
 
+/// \brief Whether `type` is the Arrow type of `T`
 template <typename T>
 inline bool is_type(const ::arrow::DataType &type)
 {
-    struct Visitor : ::arrow::TypeVisitor {
-        bool result = false;
-
-#define DF_DEFINE_VISITOR(Arrow)                                              \
-    ::arrow::Status Visit(const ::arrow::Arrow##Type &type) override          \
-    {                                                                         \
-        result = IsType<T, ::arrow::Arrow##Type>::is_type(type);              \
-        return ::arrow::Status::OK();                                         \
-    }
-
-        DF_DEFINE_VISITOR(Null)
-        DF_DEFINE_VISITOR(Boolean)
-        DF_DEFINE_VISITOR(Int8)
-        DF_DEFINE_VISITOR(Int16)
-        DF_DEFINE_VISITOR(Int32)
-        DF_DEFINE_VISITOR(Int64)
-        DF_DEFINE_VISITOR(UInt8)
-        DF_DEFINE_VISITOR(UInt16)
-        DF_DEFINE_VISITOR(UInt32)
-        DF_DEFINE_VISITOR(UInt64)
-        DF_DEFINE_VISITOR(Float)
-        DF_DEFINE_VISITOR(Double)
-        DF_DEFINE_VISITOR(HalfFloat)
-        DF_DEFINE_VISITOR(String)
-        DF_DEFINE_VISITOR(Binary)
-        DF_DEFINE_VISITOR(FixedSizeBinary)
-        DF_DEFINE_VISITOR(Date32)
-        DF_DEFINE_VISITOR(Date64)
-        DF_DEFINE_VISITOR(Timestamp)
-        DF_DEFINE_VISITOR(Time32)
-        DF_DEFINE_VISITOR(Time64)
-        DF_DEFINE_VISITOR(List)
-        DF_DEFINE_VISITOR(Struct)
-        DF_DEFINE_VISITOR(Dictionary)
-
-#undef DF_DEFINE_VISITOR
-    };
-
-    Visitor visitor;
-    DF_ARROW_ERROR_HANDLER(type.Accept(&visitor));
-
-    return visitor.result;
+    return visit_type(type.id(), [&](auto tag) {
+        using Type = typename decltype(tag)::type;
+        return IsType<T, Type>::is_type(static_cast<const Type &>(type));
+    });
 }
 
 template <typename T>
@@ -0,0 +1,145 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_TYPE_VISIT_HPP
+#define DATAFRAME_ARRAY_TYPE_VISIT_HPP
+
+#include <dataframe/error.hpp>
+#include <arrow/api.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace dataframe {
+
+/// \brief Tag passing an Arrow type class, such as `::arrow::Int32Type`, to
+/// the generic lambda or function object of `visit_type`
+template <typename ArrowType>
+struct TypeTag {
+    using type = ArrowType;
+    using array_type = typename ::arrow::TypeTraits<ArrowType>::ArrayType;
+};
+
+/// \brief Call `f(TypeTag<ArrowType>())` with the Arrow type class of `id`
+///
+/// Unlike `::arrow::TypeVisitor`, the dispatch is a switch on the type id
+/// and each case calls a kernel instantiated for its type, so `f` usually
+/// handles groups of types with `if constexpr` instead of listing them. All
+/// cases shall return the same type. Types without a case throw
+template <typename F>
+inline decltype(auto) visit_type(::arrow::Type::type id, F &&f)
+{
+    DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+    switch (id) {
+#define DF_DEFINE_CASE(ID, Arrow)                                             \
+    case ::arrow::Type::ID:                                                   \
+        return f(TypeTag<::arrow::Arrow##Type>());
+
+        DF_DEFINE_CASE(NA, Null)
+        DF_DEFINE_CASE(BOOL, Boolean)
+        DF_DEFINE_CASE(INT8, Int8)
+        DF_DEFINE_CASE(INT16, Int16)
+        DF_DEFINE_CASE(INT32, Int32)
+        DF_DEFINE_CASE(INT64, Int64)
+        DF_DEFINE_CASE(UINT8, UInt8)
+        DF_DEFINE_CASE(UINT16, UInt16)
+        DF_DEFINE_CASE(UINT32, UInt32)
+        DF_DEFINE_CASE(UINT64, UInt64)
+        DF_DEFINE_CASE(HALF_FLOAT, HalfFloat)
+        DF_DEFINE_CASE(FLOAT, Float)
+        DF_DEFINE_CASE(DOUBLE, Double)
+        DF_DEFINE_CASE(STRING, String)
+        DF_DEFINE_CASE(BINARY, Binary)
+        DF_DEFINE_CASE(FIXED_SIZE_BINARY, FixedSizeBinary)
+        DF_DEFINE_CASE(DECIMAL, Decimal128)
+        DF_DEFINE_CASE(DATE32, Date32)
+        DF_DEFINE_CASE(DATE64, Date64)
+        DF_DEFINE_CASE(TIMESTAMP, Timestamp)
+        DF_DEFINE_CASE(TIME32, Time32)
+        DF_DEFINE_CASE(TIME64, Time64)
+        DF_DEFINE_CASE(LIST, List)
+        DF_DEFINE_CASE(STRUCT, Struct)
+        DF_DEFINE_CASE(DICTIONARY, Dictionary)
+
+#undef DF_DEFINE_CASE
+
+        default:
+            break;
+    }
+    DF_DIAGNOSTIC_POP
+
+    throw DataFrameException(
+        "Unsupported Arrow type id " + std::to_string(static_cast<int>(id)));
+}
+
+template <typename F>
+inline decltype(auto) visit_type(const ::arrow::DataType &type, F &&f)
+{
+    return visit_type(type.id(), std::forward<F>(f));
+}
+
+namespace internal {
+
+/// \brief Arrow types whose values are stored as an array of `c_type`,
+/// including dates, times and half floats but not booleans
+template <typename ArrowType, typename = void>
+struct IsValueType : std::false_type {
+};
+
+template <typename ArrowType>
+struct IsValueType<ArrowType, std::void_t<typename ArrowType::c_type>>
+    : std::bool_constant<!std::is_same_v<ArrowType, ::arrow::BooleanType>> {
+};
+
+template <typename ArrowType>
+inline constexpr bool is_value_type_v = IsValueType<ArrowType>::value;
+
+/// \brief Convert IEEE half precision bits to float
+inline float half_to_float(std::uint16_t h) noexcept
+{
+    auto sign = static_cast<std::uint32_t>(h & 0x8000U) << 16;
+    auto exp = static_cast<std::uint32_t>(h >> 10) & 0x1FU;
+    auto mant = static_cast<std::uint32_t>(h) & 0x3FFU;
+
+    std::uint32_t bits = 0;
+    if (exp == 0x1F) {
+        bits = sign | 0x7F800000U | (mant << 13);
+    } else if (exp != 0) {
+        bits = sign | ((exp + 112) << 23) | (mant << 13);
+    } else if (mant != 0) {
+        // Subnormal, normalize the mantissa
+        exp = 113;
+        while ((mant & 0x400U) == 0) {
+            mant <<= 1;
+            --exp;
+        }
+        bits = sign | (exp << 23) | ((mant & 0x3FFU) << 13);
+    } else {
+        bits = sign;
+    }
+
+    float ret = 0;
+    std::memcpy(&ret, &bits, sizeof(ret));
+
+    return ret;
+}
+
+} // namespace internal
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_TYPE_VISIT_HPP
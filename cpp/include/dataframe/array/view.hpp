@@ -18,6 +18,7 @@
 #define DATAFRAME_ARRAY_VIEW_HPP
 
 #include <dataframe/array/view/bool.hpp>
+#include <dataframe/array/view/chunked.hpp>
 #include <dataframe/array/view/dict.hpp>
 #include <dataframe/array/view/list.hpp>
 #include <dataframe/array/view/null.hpp>
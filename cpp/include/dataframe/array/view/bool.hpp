@@ -18,9 +18,15 @@
 #define DATAFRAME_ARRAY_VIEW_BOOL_HPP
 
 #include <dataframe/array/view/primitive.hpp>
+#include <algorithm>
 
 namespace dataframe {
 
+/// \brief View of a boolean array
+///
+/// Besides element access, the view exposes the values and validity as
+/// 64-bit words, the `k`-th word holding elements `[64k, 64k + 64)` in order
+/// from the least significant bit, for bulk operations on masks
 template <>
 class ArrayView<bool>
 {
@@ -73,7 +79,10 @@ class ArrayView<bool>
     ArrayView(std::shared_ptr<::arrow::Array> data)
         : data_(std::move(data))
         , size_(static_cast<size_type>(data_->length()))
-        , array_(&dynamic_cast<const ::arrow::BooleanArray &>(*data_))
+        , bits_(values(*data_))
+        , null_bits_(data_->null_count() == 0 ? nullptr :
+                                                data_->null_bitmap_data())
+        , offset_(data_->offset())
     {
     }
 
@@ -85,7 +94,8 @@ class ArrayView<bool>
 
     const_reference operator[](size_type pos) const noexcept
     {
-        return array_->GetView(static_cast<std::int64_t>(pos));
+        return ::arrow::BitUtil::GetBit(
+            bits_, offset_ + static_cast<std::int64_t>(pos));
     }
 
     const_reference at(size_type pos) const
@@ -135,6 +145,99 @@ class ArrayView<bool>
         return std::numeric_limits<size_type>::max() / sizeof(value_type);
     }
 
+    // Words
+
+    /// \brief Number of 64-bit words covering the view
+    size_type nwords() const noexcept { return (size_ + 63) / 64; }
+
+    /// \brief The values of the `k`-th word, bits past the end are zero
+    std::uint64_t word(size_type k) const noexcept
+    {
+        return load(bits_, k);
+    }
+
+    /// \brief The validity of the `k`-th word, bits past the end are zero
+    std::uint64_t valid_word(size_type k) const noexcept
+    {
+        if (null_bits_ == nullptr) {
+            return load_ones(k);
+        }
+
+        return load(null_bits_, k);
+    }
+
+    /// \brief Values that are both true and valid in the `k`-th word
+    std::uint64_t set_word(size_type k) const noexcept
+    {
+        auto ret = word(k);
+
+        return null_bits_ == nullptr ? ret : ret & load(null_bits_, k);
+    }
+
+    // Bulk operations, null elements count as false
+
+    /// \brief Number of valid elements that are true
+    size_type count() const noexcept
+    {
+        auto n = nwords();
+
+        size_type ret = 0;
+        for (size_type k = 0; k != n; ++k) {
+            ret += static_cast<size_type>(
+                ::arrow::BitUtil::PopCount(set_word(k)));
+        }
+
+        return ret;
+    }
+
+    /// \brief Whether any valid element is true
+    bool any() const noexcept
+    {
+        auto n = nwords();
+        for (size_type k = 0; k != n; ++k) {
+            if (set_word(k) != 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// \brief Whether all valid elements are true, an empty view gives true
+    bool all() const noexcept
+    {
+        auto n = nwords();
+        for (size_type k = 0; k != n; ++k) {
+            if ((~word(k) & valid_word(k)) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// \brief Position of the first valid and true element at or after
+    /// `pos`, or `size()` if there is none
+    size_type find_next_set(size_type pos) const noexcept
+    {
+        if (pos >= size_) {
+            return size_;
+        }
+
+        auto n = nwords();
+        auto k = pos / 64;
+        auto w = set_word(k) & (~UINT64_C(0) << (pos % 64));
+        while (w == 0) {
+            if (++k == n) {
+                return size_;
+            }
+            w = set_word(k);
+        }
+
+        return k * 64 +
+            static_cast<size_type>(::arrow::BitUtil::CountTrailingZeros(w));
+    }
+
     template <typename OutputIter, typename Setter>
     OutputIter set(OutputIter out, Setter &&setter)
     {
@@ -146,9 +249,38 @@ class ArrayView<bool>
     }
 
   private:
+    static const std::uint8_t *values(const ::arrow::Array &array)
+    {
+        auto buffer =
+            dynamic_cast<const ::arrow::BooleanArray &>(array).values();
+
+        return buffer == nullptr ? nullptr : buffer->data();
+    }
+
+    std::int64_t remaining(size_type k) const noexcept
+    {
+        return static_cast<std::int64_t>(
+            std::min<size_type>(64, size_ - k * 64));
+    }
+
+    std::uint64_t load(const std::uint8_t *bits, size_type k) const noexcept
+    {
+        return internal::load_bits(bits,
+            offset_ + static_cast<std::int64_t>(k * 64), remaining(k));
+    }
+
+    std::uint64_t load_ones(size_type k) const noexcept
+    {
+        auto n = remaining(k);
+
+        return n == 64 ? ~UINT64_C(0) : (UINT64_C(1) << n) - 1;
+    }
+
     std::shared_ptr<::arrow::Array> data_;
-    size_type size_;
-    const ::arrow::BooleanArray *array_;
+    size_type size_ = 0;
+    const std::uint8_t *bits_ = nullptr;
+    const std::uint8_t *null_bits_ = nullptr;
+    std::int64_t offset_ = 0;
 };
 
 } // namespace dataframe
@@ -0,0 +1,208 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_ARRAY_VIEW_CHUNKED_HPP
+#define DATAFRAME_ARRAY_VIEW_CHUNKED_HPP
+
+#include <dataframe/array/view/primitive.hpp>
+#include <algorithm>
+
+namespace dataframe {
+
+/// \brief View of a sequence of chunks as one logical array
+///
+/// Elements are accessed through the `ArrayView` of each chunk, the chunks
+/// are never concatenated
+template <typename T>
+class ChunkedArrayView
+{
+  public:
+    using value_type = typename ArrayView<T>::value_type;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using reference = typename ArrayView<T>::const_reference;
+    using const_reference = reference;
+
+    class iterator
+    {
+      public:
+        using value_type = typename ChunkedArrayView::value_type;
+        using reference = typename ChunkedArrayView::reference;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        reference operator*() const noexcept
+        {
+            return ptr_->chunks_[chunk_][pos_];
+        }
+
+        iterator &operator++() noexcept
+        {
+            ++pos_;
+            skip();
+
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto ret = *this;
+            ++(*this);
+
+            return ret;
+        }
+
+        friend bool operator==(const iterator &x, const iterator &y) noexcept
+        {
+            return x.chunk_ == y.chunk_ && x.pos_ == y.pos_;
+        }
+
+        friend bool operator!=(const iterator &x, const iterator &y) noexcept
+        {
+            return !(x == y);
+        }
+
+      private:
+        friend ChunkedArrayView;
+
+        iterator(const ChunkedArrayView *ptr, size_type chunk)
+            : ptr_(ptr)
+            , chunk_(chunk)
+            , pos_(0)
+        {
+            skip();
+        }
+
+        void skip() noexcept
+        {
+            auto n = ptr_->chunks_.size();
+            while (chunk_ < n && pos_ == ptr_->chunks_[chunk_].size()) {
+                ++chunk_;
+                pos_ = 0;
+            }
+        }
+
+        const ChunkedArrayView *ptr_ = nullptr;
+        size_type chunk_ = 0;
+        size_type pos_ = 0;
+    };
+
+    using const_iterator = iterator;
+
+    ChunkedArrayView() = default;
+
+    explicit ChunkedArrayView(const ::arrow::ArrayVector &chunks)
+    {
+        chunks_.reserve(chunks.size());
+        offsets_.reserve(chunks.size() + 1);
+        offsets_.push_back(0);
+        for (auto &&chunk : chunks) {
+            chunks_.push_back(make_view<T>(chunk));
+            offsets_.push_back(offsets_.back() + chunks_.back().size());
+        }
+    }
+
+    ChunkedArrayView(const ChunkedArrayView &) = default;
+    ChunkedArrayView(ChunkedArrayView &&) noexcept = default;
+
+    ChunkedArrayView &operator=(const ChunkedArrayView &) = default;
+    ChunkedArrayView &operator=(ChunkedArrayView &&) noexcept = default;
+
+    const_reference operator[](size_type pos) const noexcept
+    {
+        auto chunk = static_cast<size_type>(
+            std::upper_bound(offsets_.begin(), offsets_.end(), pos) -
+            offsets_.begin() - 1);
+
+        return chunks_[chunk][pos - offsets_[chunk]];
+    }
+
+    const_reference at(size_type pos) const
+    {
+        if (pos >= size()) {
+            throw std::out_of_range("dataframe::ChunkedArrayView::at");
+        }
+
+        return operator[](pos);
+    }
+
+    const_reference front() const noexcept { return *begin(); }
+
+    const_reference back() const noexcept { return operator[](size() - 1); }
+
+    /// \brief Views of the individual chunks
+    const std::vector<ArrayView<T>> &chunks() const noexcept
+    {
+        return chunks_;
+    }
+
+    size_type nchunks() const noexcept { return chunks_.size(); }
+
+    // Iterators
+
+    const_iterator begin() const noexcept { return iterator(this, 0); }
+
+    const_iterator end() const noexcept
+    {
+        return iterator(this, chunks_.size());
+    }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Capacity
+
+    bool empty() const noexcept { return size() == 0; }
+
+    size_type size() const noexcept
+    {
+        return offsets_.empty() ? 0 : offsets_.back();
+    }
+
+  private:
+    std::vector<ArrayView<T>> chunks_;
+    std::vector<size_type> offsets_;
+};
+
+template <typename T>
+inline bool operator==(
+    const ChunkedArrayView<T> &v1, const ChunkedArrayView<T> &v2)
+{
+    return v1.size() == v2.size() &&
+        std::equal(v1.begin(), v1.end(), v2.begin());
+}
+
+template <typename T>
+inline bool operator!=(
+    const ChunkedArrayView<T> &v1, const ChunkedArrayView<T> &v2)
+{
+    return !(v1 == v2);
+}
+
+template <typename T>
+inline ChunkedArrayView<T> make_view(const ::arrow::ArrayVector &chunks)
+{
+    return ChunkedArrayView<T>(chunks);
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_ARRAY_VIEW_CHUNKED_HPP
@@ -18,10 +18,72 @@
 #define DATAFRAME_ARRAY_VIEW_PRIMITIVE_HPP
 
 #include <dataframe/array/type.hpp>
+#include <algorithm>
+#include <cstring>
+#include <optional>
 
 namespace dataframe {
 
+namespace internal {
+
+/// \brief Load `n <= 64` bits starting at bit `offset` of a bitmap into the
+/// low bits of a word, the remaining bits are zero
+inline std::uint64_t load_bits(
+    const std::uint8_t *bits, std::int64_t offset, std::int64_t n) noexcept
+{
+    if (n <= 0) {
+        return 0;
+    }
+
+    auto shift = offset % 8;
+    auto nbytes = static_cast<std::size_t>((shift + n + 7) / 8);
+
+    std::uint8_t buf[16] = {};
+    std::memcpy(buf, bits + offset / 8, nbytes);
+
+    std::uint64_t lo = 0;
+    std::memcpy(&lo, buf, sizeof(lo));
+    lo = ::arrow::BitUtil::FromLittleEndian(lo);
+
+    auto ret = lo;
+    if (shift != 0) {
+        auto hi = static_cast<std::uint64_t>(buf[8]);
+        ret = (lo >> shift) | (hi << (64 - shift));
+    }
+
+    return n == 64 ? ret : ret & ((UINT64_C(1) << n) - 1);
+}
+
+} // namespace internal
+
+/// \brief A block of up to 64 consecutive elements of an ArrayView together
+/// with their validity, bit `i` of `valid` is set if `values[i]` is not null
+template <typename T>
+struct ArrayBlock {
+    const T *values = nullptr;
+    std::size_t size = 0;
+    std::uint64_t valid = 0;
+
+    bool is_valid(std::size_t i) const noexcept
+    {
+        return ((valid >> i) & 1) != 0;
+    }
+
+    bool all_valid() const noexcept
+    {
+        return valid ==
+            (size == 64 ? ~UINT64_C(0) : (UINT64_C(1) << size) - 1);
+    }
+
+    bool none_valid() const noexcept { return valid == 0; }
+};
+
 /// \brief Simple class that wrap the size and pointer of a raw array
+///
+/// Element access through `operator[]` and the iterators ignores nulls, the
+/// value in a null slot is unspecified. Use `get`, `is_valid`, or the block
+/// interface (`block`, `for_each_block`, `for_each_span`) where the array may
+/// contain nulls
 template <typename T>
 class ArrayView
 {
@@ -54,6 +116,9 @@ class ArrayView
         , begin_(reinterpret_cast<const T *>(
               dynamic_cast<const ArrayType<T> &>(*data_).raw_values()))
         , end_(begin_ + size_)
+        , null_bits_(data_->null_count() == 0 ? nullptr :
+                                                data_->null_bitmap_data())
+        , offset_(data_->offset())
     {
         if (!is_type<T>(data_)) {
             throw DataFrameException("Mismatch type for view type");
@@ -80,6 +145,33 @@ class ArrayView
         return operator[](pos);
     }
 
+    /// \brief The value at `pos`, or `std::nullopt` if it is null
+    std::optional<value_type> get(size_type pos) const noexcept
+    {
+        if (is_null(pos)) {
+            return std::nullopt;
+        }
+
+        return begin_[pos];
+    }
+
+    bool is_valid(size_type pos) const noexcept
+    {
+        return null_bits_ == nullptr ||
+            ::arrow::BitUtil::GetBit(
+                null_bits_, offset_ + static_cast<std::int64_t>(pos));
+    }
+
+    bool is_null(size_type pos) const noexcept { return !is_valid(pos); }
+
+    /// \brief Number of null elements
+    size_type null_count() const noexcept
+    {
+        return null_bits_ == nullptr ?
+            0 :
+            static_cast<size_type>(data_->null_count());
+    }
+
     const_reference front() const noexcept { return operator[](0); }
 
     const_reference back() const noexcept { return operator[](size_ - 1); }
@@ -118,6 +210,91 @@ class ArrayView
         return std::numeric_limits<size_type>::max() / sizeof(value_type);
     }
 
+    // Blocks
+
+    /// \brief Number of blocks, each block holds 64 elements except possibly
+    /// the last
+    size_type nblocks() const noexcept { return (size_ + 63) / 64; }
+
+    /// \brief The `k`-th block, elements `[64k, min(64k + 64, size()))`
+    ArrayBlock<value_type> block(size_type k) const noexcept
+    {
+        ArrayBlock<value_type> ret;
+        ret.values = begin_ + k * 64;
+        ret.size = std::min<size_type>(64, size_ - k * 64);
+        ret.valid = null_bits_ == nullptr ?
+            (ret.size == 64 ? ~UINT64_C(0) :
+                              (UINT64_C(1) << ret.size) - 1) :
+            internal::load_bits(null_bits_,
+                offset_ + static_cast<std::int64_t>(k * 64),
+                static_cast<std::int64_t>(ret.size));
+
+        return ret;
+    }
+
+    /// \brief Call `f(block)` for each block in order
+    template <typename F>
+    void for_each_block(F &&f) const
+    {
+        auto n = nblocks();
+        for (size_type k = 0; k != n; ++k) {
+            f(block(k));
+        }
+    }
+
+    /// \brief Call `f(first, last)` for each maximal range of consecutive
+    /// valid elements in order
+    ///
+    /// \note If there are no nulls, `f` is called exactly once with
+    /// `[begin(), end())` provided the view is not empty. Fully valid and
+    /// fully null blocks are skipped without inspecting individual bits
+    template <typename F>
+    void for_each_span(F &&f) const
+    {
+        if (null_bits_ == nullptr) {
+            if (size_ != 0) {
+                f(begin_, end_);
+            }
+            return;
+        }
+
+        const T *first = nullptr;
+        auto n = nblocks();
+        for (size_type k = 0; k != n; ++k) {
+            auto blk = block(k);
+
+            if (blk.all_valid()) {
+                if (first == nullptr) {
+                    first = blk.values;
+                }
+                continue;
+            }
+
+            if (blk.none_valid()) {
+                if (first != nullptr) {
+                    f(first, blk.values);
+                    first = nullptr;
+                }
+                continue;
+            }
+
+            for (size_type i = 0; i != blk.size; ++i) {
+                if (blk.is_valid(i)) {
+                    if (first == nullptr) {
+                        first = blk.values + i;
+                    }
+                } else if (first != nullptr) {
+                    f(first, blk.values + i);
+                    first = nullptr;
+                }
+            }
+        }
+
+        if (first != nullptr) {
+            f(first, end_);
+        }
+    }
+
     template <typename OutputIter, typename Setter>
     OutputIter set(OutputIter out, Setter &&setter)
     {
@@ -133,6 +310,8 @@ class ArrayView
     size_type size_ = 0;
     const T *begin_ = nullptr;
     const T *end_ = nullptr;
+    const std::uint8_t *null_bits_ = nullptr;
+    std::int64_t offset_ = 0;
 };
 
 template <typename T>
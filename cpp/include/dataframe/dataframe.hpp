@@ -18,6 +18,7 @@
 #define DATAFRAME_DATAFRAME_HPP
 
 #include <dataframe/array.hpp>
+#include <dataframe/memory_pool.hpp>
 #include <dataframe/serializer.hpp>
 #include <dataframe/table.hpp>
 
@@ -26,6 +26,23 @@
         ::dataframe::ErrorHandler(call, __FILE__, __LINE__, #call);           \
     }
 
+// Switches on Arrow type ids list only the types they handle and leave the
+// others to the default case, which -Wswitch-enum would reject
+#if defined(__clang__)
+#define DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM                                      \
+    _Pragma("clang diagnostic push")                                          \
+        _Pragma("clang diagnostic ignored \"-Wswitch-enum\"")
+#define DF_DIAGNOSTIC_POP _Pragma("clang diagnostic pop")
+#elif defined(__GNUC__)
+#define DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM                                      \
+    _Pragma("GCC diagnostic push")                                            \
+        _Pragma("GCC diagnostic ignored \"-Wswitch-enum\"")
+#define DF_DIAGNOSTIC_POP _Pragma("GCC diagnostic pop")
+#else
+#define DF_DIAGNOSTIC_IGNORE_SWITCH_ENUM
+#define DF_DIAGNOSTIC_POP
+#endif
+
 namespace dataframe {
 
 class DataFrameException : public std::runtime_error
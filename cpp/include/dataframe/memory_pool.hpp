@@ -0,0 +1,300 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_MEMORY_POOL_HPP
+#define DATAFRAME_MEMORY_POOL_HPP
+
+#include <dataframe/error.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace dataframe {
+
+/// \brief A memory pool that bump allocates from large slabs and releases
+/// everything at once
+///
+/// Individual frees only return memory when they release the most recent
+/// allocation, otherwise the space is reclaimed by `reset`. It suits scratch
+/// allocations of a query, such as sort indices and intermediate selections,
+/// whose results are dropped before the next query starts. The pool must
+/// outlive all buffers allocated from it
+class ArenaMemoryPool : public ::arrow::MemoryPool
+{
+  public:
+    static constexpr std::int64_t alignment = 64;
+
+    static constexpr std::int64_t huge_page_size = 1 << 21;
+
+    /// \brief Construct a pool that allocates slabs of at least `slab_size`
+    /// bytes, backed by transparent huge pages if `huge_pages` is true and
+    /// the platform supports it
+    explicit ArenaMemoryPool(
+        std::int64_t slab_size = 1 << 22, bool huge_pages = false)
+        : slab_size_(std::max(slab_size, alignment))
+        , huge_pages_(huge_pages)
+    {
+    }
+
+    ArenaMemoryPool(const ArenaMemoryPool &) = delete;
+    ArenaMemoryPool &operator=(const ArenaMemoryPool &) = delete;
+
+    ~ArenaMemoryPool() override
+    {
+        for (auto &slab : slabs_) {
+            std::free(slab.data);
+        }
+    }
+
+    ::arrow::Status Allocate(std::int64_t size, std::uint8_t **out) override
+    {
+        if (size < 0) {
+            return ::arrow::Status::Invalid("Negative allocation size");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        ARROW_RETURN_NOT_OK(bump(size, out));
+        bytes_allocated_ += size;
+        max_memory_ = std::max(max_memory_, bytes_allocated_);
+
+        return ::arrow::Status::OK();
+    }
+
+    ::arrow::Status Reallocate(std::int64_t old_size, std::int64_t new_size,
+        std::uint8_t **ptr) override
+    {
+        if (new_size < 0) {
+            return ::arrow::Status::Invalid("Negative allocation size");
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (is_last(*ptr, old_size)) {
+            auto &slab = slabs_[current_];
+            auto begin = static_cast<std::int64_t>(*ptr - slab.data);
+            auto end = begin + round_up(new_size);
+            if (end <= slab.size) {
+                slab.used = end;
+                last_ = new_size == 0 ? nullptr : *ptr;
+                bytes_allocated_ += new_size - old_size;
+                max_memory_ = std::max(max_memory_, bytes_allocated_);
+
+                return ::arrow::Status::OK();
+            }
+        } else if (new_size <= old_size) {
+            bytes_allocated_ += new_size - old_size;
+
+            return ::arrow::Status::OK();
+        }
+
+        std::uint8_t *out = nullptr;
+        ARROW_RETURN_NOT_OK(bump(new_size, &out));
+        if (old_size != 0 && new_size != 0) {
+            std::memcpy(out, *ptr,
+                static_cast<std::size_t>(std::min(old_size, new_size)));
+        }
+        *ptr = out;
+        bytes_allocated_ += new_size - old_size;
+        max_memory_ = std::max(max_memory_, bytes_allocated_);
+
+        return ::arrow::Status::OK();
+    }
+
+    void Free(std::uint8_t *buffer, std::int64_t size) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (is_last(buffer, size)) {
+            slabs_[current_].used =
+                static_cast<std::int64_t>(buffer - slabs_[current_].data);
+            last_ = nullptr;
+        }
+
+        bytes_allocated_ -= size;
+    }
+
+    std::int64_t bytes_allocated() const override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return bytes_allocated_;
+    }
+
+    std::int64_t max_memory() const override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        return max_memory_;
+    }
+
+    /// \brief Total size of the slabs held by the pool
+    std::int64_t capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        std::int64_t ret = 0;
+        for (auto &slab : slabs_) {
+            ret += slab.size;
+        }
+
+        return ret;
+    }
+
+    /// \brief Whether `ptr` points into one of the slabs of the pool
+    bool owns(const void *ptr) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto p = static_cast<const std::uint8_t *>(ptr);
+        for (auto &slab : slabs_) {
+            if (p >= slab.data && p < slab.data + slab.size) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /// \brief Reclaim all allocations at once, keeping the slabs for reuse
+    ///
+    /// All buffers allocated from the pool must have been released
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        if (bytes_allocated_ != 0) {
+            throw DataFrameException("Cannot reset ArenaMemoryPool with " +
+                std::to_string(bytes_allocated_) + " bytes in use");
+        }
+
+        for (auto &slab : slabs_) {
+            slab.used = 0;
+        }
+        current_ = 0;
+        last_ = nullptr;
+    }
+
+    /// \brief Reset the pool and return all slabs to the system
+    void release()
+    {
+        reset();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &slab : slabs_) {
+            std::free(slab.data);
+        }
+        slabs_.clear();
+    }
+
+  private:
+    struct Slab {
+        std::uint8_t *data;
+        std::int64_t size;
+        std::int64_t used;
+    };
+
+    static std::int64_t round_up(std::int64_t size)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    bool is_last(const std::uint8_t *ptr, std::int64_t size) const
+    {
+        return ptr != nullptr && ptr == last_ && size != 0;
+    }
+
+    ::arrow::Status bump(std::int64_t size, std::uint8_t **out)
+    {
+        // Zero-size allocations share a dummy address, as in Arrow's pools
+        if (size == 0) {
+            alignas(alignment) static std::uint8_t zero_size_area[1];
+            *out = zero_size_area;
+
+            return ::arrow::Status::OK();
+        }
+
+        auto bytes = round_up(size);
+
+        while (current_ < slabs_.size()) {
+            auto &slab = slabs_[current_];
+            if (slab.used + bytes <= slab.size) {
+                *out = slab.data + slab.used;
+                slab.used += bytes;
+                last_ = *out;
+
+                return ::arrow::Status::OK();
+            }
+            ++current_;
+        }
+
+        Slab slab{nullptr, std::max(slab_size_, bytes), bytes};
+        ARROW_RETURN_NOT_OK(allocate_slab(&slab));
+        slabs_.push_back(slab);
+        current_ = slabs_.size() - 1;
+        *out = slab.data;
+        last_ = *out;
+
+        return ::arrow::Status::OK();
+    }
+
+    ::arrow::Status allocate_slab(Slab *slab) const
+    {
+        auto align = alignment;
+        if (huge_pages_) {
+            align = huge_page_size;
+            slab->size = (slab->size + align - 1) / align * align;
+        }
+
+        void *data = nullptr;
+        if (::posix_memalign(&data, static_cast<std::size_t>(align),
+                static_cast<std::size_t>(slab->size)) != 0) {
+            return ::arrow::Status::OutOfMemory(
+                "ArenaMemoryPool failed to allocate ", slab->size, " bytes");
+        }
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (huge_pages_) {
+            // Advisory only, the slab is usable without huge pages
+            ::madvise(data, static_cast<std::size_t>(slab->size),
+                MADV_HUGEPAGE);
+        }
+#endif
+
+        slab->data = static_cast<std::uint8_t *>(data);
+
+        return ::arrow::Status::OK();
+    }
+
+    std::int64_t slab_size_;
+    bool huge_pages_;
+    mutable std::mutex mutex_;
+    std::vector<Slab> slabs_;
+    std::size_t current_ = 0;
+    std::uint8_t *last_ = nullptr;
+    std::int64_t bytes_allocated_ = 0;
+    std::int64_t max_memory_ = 0;
+};
+
+} // namespace dataframe
+
+#endif // DATAFRAME_MEMORY_POOL_HPP
@@ -20,11 +20,236 @@
 #include <dataframe/table.hpp>
 #include <arrow/io/api.h>
 #include <arrow/ipc/api.h>
+#include <arrow/util/key_value_metadata.h>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
 namespace dataframe {
 
+namespace internal {
+
+// Column statistics are stored in the schema metadata under the keys
+// "dataframe.stats.<column>.<field>"
+inline std::string stats_key(const std::string &name, const char *field)
+{
+    return "dataframe.stats." + name + "." + field;
+}
+
+inline std::string encode_stats_value(const ColumnStats::value_type &value)
+{
+    struct Visitor {
+        std::string operator()(std::monostate) const { return std::string(); }
+
+        std::string operator()(std::int64_t v) const
+        {
+            return "i:" + std::to_string(v);
+        }
+
+        std::string operator()(std::uint64_t v) const
+        {
+            return "u:" + std::to_string(v);
+        }
+
+        std::string operator()(double v) const
+        {
+            char buf[64];
+            std::snprintf(buf, sizeof(buf), "d:%a", v);
+
+            return buf;
+        }
+
+        std::string operator()(const std::string &v) const
+        {
+            return "s:" + v;
+        }
+    };
+
+    return std::visit(Visitor(), value);
+}
+
+inline ColumnStats::value_type decode_stats_value(const std::string &str)
+{
+    if (str.size() < 2 || str[1] != ':') {
+        return std::monostate();
+    }
+
+    auto text = str.substr(2);
+    switch (str[0]) {
+        case 'i':
+            return static_cast<std::int64_t>(
+                std::strtoll(text.c_str(), nullptr, 10));
+        case 'u':
+            return static_cast<std::uint64_t>(
+                std::strtoull(text.c_str(), nullptr, 10));
+        case 'd':
+            return std::strtod(text.c_str(), nullptr);
+        case 's':
+            return text;
+        default:
+            return std::monostate();
+    }
+}
+
+inline bool is_stats_key(const std::string &key)
+{
+    static const std::string prefix = "dataframe.stats.";
+
+    return key.compare(0, prefix.size(), prefix) == 0;
+}
+
+/// \brief A copy of the metadata without any statistics keys, those of a
+/// table whose columns have since been changed are no longer valid
+inline std::shared_ptr<::arrow::KeyValueMetadata> strip_stats(
+    const std::shared_ptr<const ::arrow::KeyValueMetadata> &metadata)
+{
+    auto ret = std::make_shared<::arrow::KeyValueMetadata>();
+    if (metadata == nullptr) {
+        return ret;
+    }
+
+    auto n = metadata->size();
+    for (std::int64_t i = 0; i != n; ++i) {
+        if (!is_stats_key(metadata->key(i))) {
+            ret->Append(metadata->key(i), metadata->value(i));
+        }
+    }
+
+    return ret;
+}
+
+inline bool has_stats(
+    const std::shared_ptr<const ::arrow::KeyValueMetadata> &metadata)
+{
+    if (metadata == nullptr) {
+        return false;
+    }
+
+    auto n = metadata->size();
+    for (std::int64_t i = 0; i != n; ++i) {
+        if (is_stats_key(metadata->key(i))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// \brief The table of a DataFrame with the statistics of its columns
+/// replacing any in the schema metadata
+inline std::shared_ptr<::arrow::Table> table_with_stats(const DataFrame &df)
+{
+    auto &table = df.table();
+    auto metadata = strip_stats(table.schema()->metadata());
+
+    auto ncol = df.ncol();
+    for (std::size_t i = 0; i != ncol; ++i) {
+        auto col = df[i];
+        auto stats = col.stats();
+        auto &name = col.name();
+
+        metadata->Append(stats_key(name, "type"), col.type()->ToString());
+        metadata->Append(
+            stats_key(name, "length"), std::to_string(stats->length));
+        metadata->Append(
+            stats_key(name, "null_count"), std::to_string(stats->null_count));
+        metadata->Append(
+            stats_key(name, "nan_count"), std::to_string(stats->nan_count));
+        metadata->Append(stats_key(name, "sorted"), stats->sorted ? "1" : "0");
+        metadata->Append(stats_key(name, "ndv"), std::to_string(stats->ndv));
+        metadata->Append(
+            stats_key(name, "min"), encode_stats_value(stats->min));
+        metadata->Append(
+            stats_key(name, "max"), encode_stats_value(stats->max));
+    }
+
+    return table.ReplaceSchemaMetadata(metadata);
+}
+
+/// \brief The table of a DataFrame without statistics in the schema
+/// metadata, or nullptr if it has none
+inline std::shared_ptr<::arrow::Table> table_without_stats(
+    const DataFrame &df)
+{
+    auto &table = df.table();
+    if (!has_stats(table.schema()->metadata())) {
+        return nullptr;
+    }
+
+    return table.ReplaceSchemaMetadata(
+        strip_stats(table.schema()->metadata()));
+}
+
+/// \brief Restore column statistics written by `table_with_stats`
+///
+/// \return The DataFrame with the statistics removed from its schema
+/// metadata, they are kept by the columns from then on
+inline DataFrame read_stats(DataFrame df)
+{
+    if (!df) {
+        return df;
+    }
+
+    auto metadata = df.table().schema()->metadata();
+    if (!has_stats(metadata)) {
+        return df;
+    }
+
+    DataFrame ret(df.table().ReplaceSchemaMetadata(strip_stats(metadata)));
+
+    auto find = [&](const std::string &name, const char *field) {
+        auto index = metadata->FindKey(stats_key(name, field));
+
+        return index < 0 ? std::string() : metadata->value(index);
+    };
+
+    auto ncol = ret.ncol();
+    for (std::size_t i = 0; i != ncol; ++i) {
+        auto col = ret[i];
+        auto &name = col.name();
+
+        // Skip statistics that do not describe the column as read
+        auto length = find(name, "length");
+        if (length.empty() ||
+            std::strtoull(length.c_str(), nullptr, 10) != col.size()) {
+            continue;
+        }
+
+        if (find(name, "type") != col.type()->ToString()) {
+            continue;
+        }
+
+        ColumnStats stats;
+        stats.length = col.size();
+        stats.null_count = static_cast<std::size_t>(
+            std::strtoull(find(name, "null_count").c_str(), nullptr, 10));
+        if (stats.null_count != col.null_count()) {
+            continue;
+        }
+
+        // Older statistics counted NaN in the order and the bounds
+        auto nan_count = find(name, "nan_count");
+        if (nan_count.empty()) {
+            continue;
+        }
+        stats.nan_count = static_cast<std::size_t>(
+            std::strtoull(nan_count.c_str(), nullptr, 10));
+
+        stats.sorted = find(name, "sorted") == "1";
+        stats.ndv = static_cast<std::size_t>(
+            std::strtoull(find(name, "ndv").c_str(), nullptr, 10));
+        stats.min = decode_stats_value(find(name, "min"));
+        stats.max = decode_stats_value(find(name, "max"));
+
+        col.set_stats(std::move(stats));
+    }
+
+    return ret;
+}
+
+} // namespace internal
+
 class CopyBufferReader : public ::arrow::io::BufferReader
 {
   public:
@@ -59,20 +59,17 @@ class FeatherWriter : public Writer
         DF_ARROW_ERROR_HANDLER(
             ::arrow::io::BufferOutputStream::Create(0, pool_, &stream));
 
-        auto &table = df.table();
         std::unique_ptr<::arrow::ipc::feather::TableWriter> writer;
         DF_ARROW_ERROR_HANDLER(
             ::arrow::ipc::feather::TableWriter::Open(stream, &writer));
-        writer->SetNumRows(table.num_rows());
-
-        auto ncols = table.num_columns();
-        for (auto i = 0; i != ncols; ++i) {
-            auto col = table.column(i);
-            auto chunks = col->data()->chunks();
-            for (auto &&ary : chunks) {
-                DF_ARROW_ERROR_HANDLER(
-                    writer->Append(col->field()->name(), *ary));
-            }
+        writer->SetNumRows(static_cast<std::int64_t>(df.nrow()));
+
+        // Feather stores each column as a single array, columns with
+        // multiple chunks are combined one at a time
+        auto ncol = df.ncol();
+        for (std::size_t i = 0; i != ncol; ++i) {
+            auto col = df[i];
+            DF_ARROW_ERROR_HANDLER(writer->Append(col.name(), *col.data()));
         }
 
         DF_ARROW_ERROR_HANDLER(writer->Finalize());
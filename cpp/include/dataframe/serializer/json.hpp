@@ -29,11 +29,20 @@ namespace dataframe {
 
 class JSONRowWriter : public Writer
 {
+    // The rows covered by one chunk of a column
+    struct Rows {
+        ::rapidjson::Document *first;
+        ::rapidjson::Document *last;
+
+        ::rapidjson::Document *begin() const { return first; }
+        ::rapidjson::Document *end() const { return last; }
+    };
+
     struct Visitor : ::arrow::ArrayVisitor {
         ::rapidjson::GenericStringRef<char> key;
-        std::vector<::rapidjson::Document> &rows;
+        Rows rows;
 
-        Visitor(const std::string &k, std::vector<::rapidjson::Document> &r)
+        Visitor(const std::string &k, Rows r)
             : key(k.data(), static_cast<unsigned>(k.size()))
             , rows(r)
         {
@@ -282,8 +291,13 @@ class JSONRowWriter : public Writer
 
         for (std::size_t i = 0; i != ncol; ++i) {
             auto col = df[i];
-            Visitor visitor(keys[i], rows);
-            DF_ARROW_ERROR_HANDLER(col.data()->Accept(&visitor));
+            auto first = rows.data();
+            for (auto &&chunk : col.chunks()) {
+                auto last = first + chunk->length();
+                Visitor visitor(keys[i], Rows{first, last});
+                DF_ARROW_ERROR_HANDLER(chunk->Accept(&visitor));
+                first = last;
+            }
         }
 
         ::rapidjson::Value data(::rapidjson::kArrayType);
@@ -558,7 +572,9 @@ class JSONColumnWriter : public Writer
             Visitor visitor;
             visitor.root = &root;
             visitor.value = &value;
-            DF_ARROW_ERROR_HANDLER(col.data()->Accept(&visitor));
+            for (auto &&chunk : col.chunks()) {
+                DF_ARROW_ERROR_HANDLER(chunk->Accept(&visitor));
+            }
             root.AddMember(key, value, root.GetAllocator());
         }
 
@@ -24,9 +24,13 @@ namespace dataframe {
 class RecordBatchStreamWriter : public Writer
 {
   public:
+    /// \brief Construct a writer, optionally storing the statistics of each
+    /// column in the schema metadata
     explicit RecordBatchStreamWriter(
-        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool(),
+        bool write_stats = false)
         : pool_(pool)
+        , write_stats_(write_stats)
     {
     }
 
@@ -55,14 +59,20 @@ class RecordBatchStreamWriter : public Writer
             return;
         }
 
+        // Statistics left in the metadata may be stale, they are replaced
+        // or removed
+        auto with_stats = write_stats_ ? internal::table_with_stats(df) :
+                                         internal::table_without_stats(df);
+        auto &table = with_stats == nullptr ? df.table() : *with_stats;
+
         std::shared_ptr<::arrow::io::BufferOutputStream> stream;
         DF_ARROW_ERROR_HANDLER(
             ::arrow::io::BufferOutputStream::Create(0, pool_, &stream));
         std::shared_ptr<::arrow::ipc::RecordBatchWriter> writer;
 
         DF_ARROW_ERROR_HANDLER(::arrow::ipc::RecordBatchStreamWriter::Open(
-            stream.get(), df.table().schema(), &writer));
-        DF_ARROW_ERROR_HANDLER(writer->WriteTable(df.table()));
+            stream.get(), table.schema(), &writer));
+        DF_ARROW_ERROR_HANDLER(writer->WriteTable(table));
         DF_ARROW_ERROR_HANDLER(writer->Close());
         DF_ARROW_ERROR_HANDLER(stream->Finish(&buffer_));
     }
@@ -71,6 +81,7 @@ class RecordBatchStreamWriter : public Writer
 
   private:
     ::arrow::MemoryPool *pool_;
+    bool write_stats_;
     std::shared_ptr<::arrow::Buffer> buffer_;
 };
 
@@ -113,7 +124,7 @@ class RecordBatchStreamReader : public Reader
         DF_ARROW_ERROR_HANDLER(
             ::arrow::Table::FromRecordBatches(batches, &table));
 
-        return DataFrame(std::move(table));
+        return internal::read_stats(DataFrame(std::move(table)));
     }
 
     ::arrow::MemoryPool *memory_pool() const { return pool_; }
@@ -18,14 +18,18 @@
 #define DATAFRAME_TABLE_HPP
 
 #include <dataframe/table/bind.hpp>
+#include <dataframe/table/builder.hpp>
 #include <dataframe/table/column.hpp>
 #include <dataframe/table/data_frame.hpp>
 #include <dataframe/table/data_view.hpp>
 #include <dataframe/table/join.hpp>
 #include <dataframe/table/make.hpp>
+#include <dataframe/table/memory.hpp>
+#include <dataframe/table/runs.hpp>
 #include <dataframe/table/select.hpp>
 #include <dataframe/table/sort.hpp>
 #include <dataframe/table/splice.hpp>
 #include <dataframe/table/split.hpp>
+#include <dataframe/table/typed_frame.hpp>
 
 #endif // DATAFRAME_TABLE_HPP
@@ -18,12 +18,21 @@
 #define DATAFRAME_TABLE_BIND_HPP
 
 #include <dataframe/table/data_frame.hpp>
-#include <map>
+#include <arrow/util/parallel.h>
+#include <unordered_map>
 
 namespace dataframe {
 
+/// \brief Bind the rows of DataFrames by column name
+///
+/// The result contains the union of all columns. Columns missing from a
+/// DataFrame are filled with nulls, numeric columns are widened to a common
+/// type and dictionary columns have their dictionaries unified. Columns
+/// with multiple chunks in any of the DataFrames, such as those from
+/// `encode_runs`, keep their chunks instead of being concatenated
 template <typename InputIter>
-inline DataFrame bind_rows(InputIter first, InputIter last)
+inline DataFrame bind_rows(InputIter first, InputIter last,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
     DataFrame ret;
 
@@ -37,48 +46,107 @@ inline DataFrame bind_rows(InputIter first, InputIter last)
         return ret;
     }
 
-    while (first != last && first->empty()) {
-        ++first;
+    std::vector<const ::arrow::Table *> tables;
+    for (auto iter = first; iter != last; ++iter) {
+        if (!iter->empty()) {
+            tables.push_back(&iter->table());
+        }
     }
 
-    if (first == last) {
+    if (tables.empty()) {
         return ret;
     }
 
-    std::vector<std::string> keys;
-    std::map<std::string, std::vector<std::shared_ptr<::arrow::Array>>> chunks;
+    std::vector<std::string> names;
+    std::vector<std::shared_ptr<::arrow::DataType>> types;
+    std::unordered_map<std::string, std::size_t> index;
+    for (auto table : tables) {
+        for (auto &&field : table->schema()->fields()) {
+            auto iter = index.emplace(field->name(), names.size());
+            if (iter.second) {
+                names.push_back(field->name());
+                types.push_back(field->type());
+                continue;
+            }
 
-    auto ncol = first->ncol();
-    for (std::size_t i = 0; i != ncol; ++i) {
-        auto col = first->at(i);
-        keys.push_back(col.name());
-        chunks[keys.back()] = {col.data()};
+            auto &type = types[iter.first->second];
+            auto common = promote_type(type, field->type());
+            if (common == nullptr) {
+                throw DataFrameException("Cannot bind column '" +
+                    field->name() + "', no common type for " +
+                    type->ToString() + " and " + field->type()->ToString());
+            }
+            type = std::move(common);
+        }
     }
-    ++first;
 
-    while (first != last) {
-        if (first->empty()) {
-            ++first;
-            continue;
-        }
+    auto ncol = static_cast<int>(names.size());
+
+    std::vector<::arrow::ArrayVector> chunks(names.size());
+    std::vector<bool> chunked(names.size());
+    for (auto table : tables) {
+        for (std::size_t i = 0; i != names.size(); ++i) {
+            auto &chk = chunks[i];
+            auto k = table->schema()->GetFieldIndex(names[i]);
+            if (k < 0) {
+                chk.push_back(promote_array(
+                    std::make_shared<::arrow::NullArray>(table->num_rows()),
+                    types[i], pool));
+                continue;
+            }
 
-        if (first->ncol() != ncol) {
-            throw DataFrameException("Different number of columns");
+            auto &data = table->column(k)->data()->chunks();
+            chunked[i] = chunked[i] || data.size() > 1;
+            for (auto &&chunk : data) {
+                chk.push_back(promote_array(chunk, types[i], pool));
+            }
         }
+    }
 
-        for (std::size_t i = 0; i != ncol; ++i) {
-            auto col = first->at(i);
-            chunks.at(col.name()).push_back(col.data());
+    // Columns that are already chunked, such as run encoded columns, keep
+    // their chunks unless they need to be unified. Dictionary types compare
+    // equal without comparing the dictionaries, so those are always unified
+    for (std::size_t i = 0; i != chunks.size(); ++i) {
+        if (types[i]->id() == ::arrow::Type::DICTIONARY) {
+            chunked[i] = false;
+        } else if (chunked[i]) {
+            for (auto &&chunk : chunks[i]) {
+                if (!chunk->type()->Equals(*types[i])) {
+                    chunked[i] = false;
+                    break;
+                }
+            }
         }
-
-        ++first;
     }
 
-    for (auto &key : keys) {
-        ret[key] = bind_array(chunks.at(key));
+    std::vector<std::shared_ptr<::arrow::Array>> arrays(chunks.size());
+    DF_ARROW_ERROR_HANDLER(::arrow::internal::ParallelFor(ncol, [&](int i) {
+        auto k = static_cast<std::size_t>(i);
+        if (chunked[k]) {
+            return ::arrow::Status::OK();
+        }
+        return internal::bind_array(chunks[k], pool, &arrays[k]);
+    }));
+
+    std::vector<std::shared_ptr<::arrow::Field>> fields;
+    std::vector<std::shared_ptr<::arrow::Column>> columns;
+    fields.reserve(arrays.size());
+    columns.reserve(arrays.size());
+    for (std::size_t i = 0; i != arrays.size(); ++i) {
+        if (chunked[i]) {
+            fields.push_back(::arrow::field(names[i], types[i]));
+            columns.push_back(std::make_shared<::arrow::Column>(fields.back(),
+                std::make_shared<::arrow::ChunkedArray>(
+                    std::move(chunks[i]), types[i])));
+        } else {
+            fields.push_back(::arrow::field(names[i], arrays[i]->type()));
+            columns.push_back(
+                std::make_shared<::arrow::Column>(fields.back(), arrays[i]));
+        }
     }
 
-    return ret;
+    return DataFrame(::arrow::Table::Make(
+        std::make_shared<::arrow::Schema>(std::move(fields)), columns));
 }
 
 template <typename InputIter>
@@ -96,6 +164,7 @@ inline DataFrame bind_cols(InputIter first, InputIter last)
         return ret;
     }
 
+    std::vector<ConstColumnProxy> columns;
     while (first != last) {
         const auto &df = *first++;
 
@@ -105,21 +174,17 @@ inline DataFrame bind_cols(InputIter first, InputIter last)
 
         auto ncol = df.ncol();
         for (std::size_t i = 0; i != ncol; ++i) {
-            auto col = df[i];
-            if (ret[col.name()]) {
-                throw DataFrameException(
-                    "Duplicate column name " + col.name());
-            }
-            ret[col.name()] = col;
+            columns.push_back(df[i]);
         }
     }
 
-    return ret;
+    return DataFrame(internal::make_table(columns));
 }
 
-inline DataFrame bind_rows(const std::vector<DataFrame> &dfs)
+inline DataFrame bind_rows(const std::vector<DataFrame> &dfs,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
-    return bind_rows(dfs.begin(), dfs.end());
+    return bind_rows(dfs.begin(), dfs.end(), pool);
 }
 
 inline DataFrame bind_cols(const std::vector<DataFrame> &dfs)
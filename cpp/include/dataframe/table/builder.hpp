@@ -0,0 +1,184 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_TABLE_BUILDER_HPP
+#define DATAFRAME_TABLE_BUILDER_HPP
+
+#include <dataframe/table/data_frame.hpp>
+#include <array>
+#include <tuple>
+
+namespace dataframe {
+
+namespace internal {
+
+// The value appended for a row, strings are viewed instead of copied
+template <typename T>
+struct BuilderValue {
+    using type = T;
+};
+
+template <>
+struct BuilderValue<std::string> {
+    using type = std::string_view;
+};
+
+template <>
+struct BuilderValue<Bytes> {
+    using type = std::string_view;
+};
+
+} // namespace internal
+
+/// \brief Builder of small DataFrames with a fixed schema
+///
+/// The schema and the column builders are created once and reused for every
+/// DataFrame. Rows are appended directly to the Arrow builders, and each
+/// `finish` hands their buffers over to the arrays of a single table,
+/// instead of building a schema and a table per column as with
+/// `ColumnProxy` assignment. After `finish` the builders reserve as many
+/// rows as the last DataFrame had, so that a steady stream of frames of
+/// similar sizes does not regrow them row by row
+template <typename... Types>
+class DataFrameBuilder
+{
+    static_assert(sizeof...(Types) != 0, "DataFrame without columns");
+
+  public:
+    static constexpr std::size_t ncol = sizeof...(Types);
+
+    explicit DataFrameBuilder(const std::array<std::string, ncol> &names,
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+        : builders_(make_builder<Types>(pool)...)
+        , pool_(pool)
+    {
+        std::vector<std::shared_ptr<::arrow::DataType>> types = {
+            make_data_type<Types>()...};
+
+        std::vector<std::shared_ptr<::arrow::Field>> fields;
+        for (std::size_t i = 0; i != ncol; ++i) {
+            for (std::size_t j = 0; j != i; ++j) {
+                if (names[i] == names[j]) {
+                    throw DataFrameException(
+                        "Duplicate column name " + names[i]);
+                }
+            }
+            fields.push_back(::arrow::field(names[i], types[i]));
+        }
+
+        schema_ = ::arrow::schema(std::move(fields));
+    }
+
+    /// \brief Reserve space for `n` more rows
+    void reserve(std::size_t n)
+    {
+        std::apply([&](auto &... b) { (reserve_rows(b.get(), n), ...); },
+            builders_);
+    }
+
+    /// \brief Append a row
+    template <typename... Args>
+    void append(Args &&... args)
+    {
+        static_assert(sizeof...(Args) == ncol, "Wrong number of values");
+
+        append_row(std::index_sequence_for<Types...>(),
+            std::forward<Args>(args)...);
+    }
+
+    /// \brief Discard the rows appended since the last `finish`
+    void reset()
+    {
+        std::apply([](auto &... b) { (b->Reset(), ...); }, builders_);
+        size_ = 0;
+    }
+
+    /// \brief Number of rows appended since the last `finish`
+    std::size_t size() const { return size_; }
+
+    bool empty() const { return size() == 0; }
+
+    const std::shared_ptr<::arrow::Schema> &schema() const { return schema_; }
+
+    /// \brief Construct a DataFrame from the appended rows and reset the
+    /// builder for reuse
+    DataFrame finish()
+    {
+        std::vector<std::shared_ptr<::arrow::Array>> arrays;
+        arrays.reserve(ncol);
+        finish_columns(std::index_sequence_for<Types...>(), arrays);
+
+        auto nrow = size_;
+        size_ = 0;
+        reserve(nrow);
+
+        return DataFrame(::arrow::Table::Make(
+            schema_, arrays, static_cast<std::int64_t>(nrow)));
+    }
+
+  private:
+    template <std::size_t... I, typename... Args>
+    void append_row(std::index_sequence<I...>, Args &&... args)
+    {
+        (append_value<Types>(
+             std::get<I>(builders_).get(), std::forward<Args>(args)),
+            ...);
+        ++size_;
+    }
+
+    static void reserve_rows(::arrow::ArrayBuilder *builder, std::size_t n)
+    {
+        DF_ARROW_ERROR_HANDLER(
+            builder->Reserve(static_cast<std::int64_t>(n)));
+    }
+
+    template <typename T, typename Arg>
+    static void append_value(BuilderType<T> *builder, Arg &&arg)
+    {
+        typename internal::BuilderValue<T>::type value(
+            std::forward<Arg>(arg));
+        ArrayMaker<T>::append(builder, &value, &value + 1);
+    }
+
+    template <std::size_t... I>
+    void finish_columns(std::index_sequence<I...>,
+        std::vector<std::shared_ptr<::arrow::Array>> &arrays)
+    {
+        (arrays.push_back(
+             finish_column<Types>(std::get<I>(builders_).get())),
+            ...);
+    }
+
+    template <typename T>
+    std::shared_ptr<::arrow::Array> finish_column(BuilderType<T> *builder)
+    {
+        // Finish resets the builder, which can then be refilled
+        std::shared_ptr<::arrow::Array> ret;
+        DF_ARROW_ERROR_HANDLER(builder->Finish(&ret));
+
+        return cast_array<T>(ret, pool_);
+    }
+
+  private:
+    std::shared_ptr<::arrow::Schema> schema_;
+    std::tuple<std::unique_ptr<BuilderType<Types>>...> builders_;
+    std::size_t size_ = 0;
+    ::arrow::MemoryPool *pool_;
+};
+
+} // namespace dataframe
+
+#endif // DATAFRAME_TABLE_BUILDER_HPP
@@ -21,7 +21,22 @@
 
 namespace dataframe {
 
+namespace internal {
+
+/// \brief Concatenation of the chunks of a column of a table, shared by the
+/// proxies of that column so that it is computed at most once
+struct CombinedChunks {
+    std::weak_ptr<::arrow::ChunkedArray> chunks;
+    std::shared_ptr<::arrow::Array> data;
+};
+
+} // namespace internal
+
 /// \brief Constant proxy class of DataFrame column
+///
+/// A column may consist of multiple chunks, in which case `chunks()` and
+/// `chunked_view` give access to the data without concatenation, and only
+/// `data()` and the contiguous views combine the chunks on demand
 class ConstColumnProxy
 {
   public:
@@ -33,44 +48,52 @@ class ConstColumnProxy
     {
     }
 
+    ConstColumnProxy(
+        std::string name, std::shared_ptr<::arrow::ChunkedArray> chunks)
+        : name_(std::move(name))
+    {
+        set_chunks(std::move(chunks));
+    }
+
     ConstColumnProxy(const std::shared_ptr<::arrow::Column> &column)
     {
         if (column == nullptr) {
             return;
         }
 
-        auto &chunks = column->data()->chunks();
-        if (chunks.size() != 1) {
-            throw DataFrameException("Chunked array not supported");
-        }
-
         name_ = column->name();
-        data_ = chunks.front();
+        set_chunks(column->data());
     }
 
     ConstColumnProxy(
         std::string name, const std::shared_ptr<::arrow::Table> &table)
-        : name_(std::move(name))
+        : ConstColumnProxy(name, table,
+              table == nullptr ? -1 : table->schema()->GetFieldIndex(name))
     {
-        if (table == nullptr) {
-            return;
-        }
+    }
 
-        auto index = table->schema()->GetFieldIndex(name_);
-        if (index < 0) {
+    /// \brief Construct from the column at a known position of the table, a
+    /// negative index gives a null column
+    ///
+    /// If `combined` is not null, the concatenation of multiple chunks is
+    /// shared through it with other proxies of the same column
+    ConstColumnProxy(std::string name,
+        const std::shared_ptr<::arrow::Table> &table, int index,
+        std::shared_ptr<internal::CombinedChunks> combined = nullptr)
+        : name_(std::move(name))
+        , combined_(std::move(combined))
+    {
+        if (table == nullptr || index < 0) {
             return;
         }
 
-        auto &chunks =
-            table->column(static_cast<int>(index))->data()->chunks();
-        if (chunks.size() != 1) {
-            throw DataFrameException("Chunked array not supported");
-        }
-
-        data_ = chunks.front();
+        set_chunks(table->column(index)->data());
     }
 
-    explicit operator bool() const { return data_ != nullptr; }
+    explicit operator bool() const
+    {
+        return data_ != nullptr || chunked_ != nullptr;
+    }
 
     template <typename T>
     operator ArrayView<T>() const
@@ -79,16 +102,40 @@ class ConstColumnProxy
     }
 
     /// \brief Cast the column to a given destination type
+    ///
+    /// The result of a conversion is cached for the data of the column,
+    /// repeated casts to the same type are free until the column is
+    /// reassigned. Reinterpretations share the buffers of the column and are
+    /// cheap to redo, so they are not cached. Casts into another memory pool
+    /// than the default are not cached, such that the result is always
+    /// allocated from `pool`
     template <typename T>
     ArrayView<T> as(
         ::arrow::MemoryPool *pool = ::arrow::default_memory_pool()) const
     {
-        if (data_ == nullptr) {
+        if (!*this) {
             throw DataFrameException(
                 "Attempt to access an empty column '" + name_ + "'");
         }
 
-        return make_view<T>(cast_array<T>(data_, pool));
+        if (pool != ::arrow::default_memory_pool()) {
+            return make_view<T>(cast_array<T>(data(), pool));
+        }
+
+        auto &cache = internal::CastCache::instance();
+        auto key = stats_key();
+        std::type_index type(typeid(T));
+
+        auto ret = cache.find(key, type);
+        if (ret == nullptr) {
+            auto &array = data();
+            ret = cast_array<T>(array, pool);
+            if (cast_kind<T>(*array) == CastKind::Convert) {
+                cache.insert(key, type, ret);
+            }
+        }
+
+        return make_view<T>(std::move(ret));
     }
 
     /// \brief Same as `as` but will throw if not aready of the destination
@@ -96,83 +143,183 @@ class ConstColumnProxy
     template <typename T>
     ArrayView<T> view() const
     {
-        if (data_ == nullptr) {
+        if (!*this) {
             throw DataFrameException(
                 "Attempt to access an empty column '" + name_ + "'");
         }
 
-        return make_view<T>(data_);
+        return make_view<T>(data());
+    }
+
+    /// \brief Same as `as` but cast each chunk separately
+    template <typename T>
+    ChunkedArrayView<T> chunked_as(
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool()) const
+    {
+        if (!*this) {
+            throw DataFrameException(
+                "Attempt to access an empty column '" + name_ + "'");
+        }
+
+        ::arrow::ArrayVector chunks;
+        for (auto &&chunk : this->chunks()) {
+            chunks.push_back(cast_array<T>(chunk, pool));
+        }
+
+        return make_view<T>(chunks);
+    }
+
+    /// \brief Same as `view` but without concatenating chunks
+    template <typename T>
+    ChunkedArrayView<T> chunked_view() const
+    {
+        if (!*this) {
+            throw DataFrameException(
+                "Attempt to access an empty column '" + name_ + "'");
+        }
+
+        return make_view<T>(chunks());
     }
 
     template <typename T>
     bool is_type() const
     {
-        if (data_ == nullptr) {
+        if (!*this) {
             throw DataFrameException(
                 "Attempt to access an empty column '" + name_ + "'");
         }
 
-        return ::dataframe::is_type<T>(data_);
+        return ::dataframe::is_type<T>(type());
     }
 
-    bool is_integer() const
+    /// \brief The Arrow type id of the column
+    ::arrow::Type::type type_id() const
     {
-        return is_type<std::int8_t>() || is_type<std::int16_t>() ||
-            is_type<std::int32_t>() || is_type<std::int64_t>() ||
-            is_type<std::uint8_t>() || is_type<std::uint16_t>() ||
-            is_type<std::uint32_t>() || is_type<std::uint64_t>();
+        if (!*this) {
+            throw DataFrameException(
+                "Attempt to access an empty column '" + name_ + "'");
+        }
+
+        return type()->id();
     }
 
-    bool is_real() const { return is_type<float>() || is_type<double>(); }
+    bool is_integer() const { return ::arrow::is_integer(type_id()); }
+
+    bool is_real() const
+    {
+        auto id = type_id();
+
+        return id == ::arrow::Type::FLOAT || id == ::arrow::Type::DOUBLE;
+    }
 
-    bool is_binary() const { return is_type<std::string>(); }
+    bool is_binary() const { return type_id() == ::arrow::Type::STRING; }
 
     bool is_timestamp() const
     {
-        return is_type<Timestamp<TimeUnit::Second>>() ||
-            is_type<Timestamp<TimeUnit::Millisecond>>() ||
-            is_type<Timestamp<TimeUnit::Microsecond>>() ||
-            is_type<Timestamp<TimeUnit::Nanosecond>>();
+        return type_id() == ::arrow::Type::TIMESTAMP;
     }
 
     bool is_time() const
     {
-        return is_type<Time<TimeUnit::Second>>() ||
-            is_type<Time<TimeUnit::Millisecond>>() ||
-            is_type<Time<TimeUnit::Microsecond>>() ||
-            is_type<Time<TimeUnit::Nanosecond>>();
+        auto id = type_id();
+
+        return id == ::arrow::Type::TIME32 || id == ::arrow::Type::TIME64;
     }
 
     /// \brief Slice the column with close-open interval `[begin, end)`
     ConstColumnProxy operator()(std::size_t begin, std::size_t end) const
     {
-        if (static_cast<std::int64_t>(end) > data_->length()) {
+        auto length = static_cast<std::int64_t>(size());
+
+        if (static_cast<std::int64_t>(end) > length) {
             throw DataFrameException("Slicing out of range, begin: " +
                 std::to_string(begin) + ", end: " + std::to_string(end) +
-                ", length: " + std::to_string(data_->length()));
+                ", length: " + std::to_string(length));
         }
 
         if (end <= begin) {
             return ConstColumnProxy();
         }
 
-        if (static_cast<std::int64_t>(begin) == data_->length()) {
+        if (static_cast<std::int64_t>(begin) == length) {
             return ConstColumnProxy();
         }
 
-        return ConstColumnProxy(name_,
-            data_->Slice(static_cast<std::int64_t>(begin),
-                static_cast<std::int64_t>(end - begin)));
+        auto offset = static_cast<std::int64_t>(begin);
+        auto len = static_cast<std::int64_t>(end - begin);
+
+        if (chunked_ != nullptr) {
+            return ConstColumnProxy(name_, chunked_->Slice(offset, len));
+        }
+
+        return ConstColumnProxy(name_, data_->Slice(offset, len));
     }
 
     const std::string &name() const { return name_; }
 
-    const std::shared_ptr<::arrow::Array> &data() const { return data_; }
+    /// \brief The contiguous data of the column, multiple chunks are
+    /// concatenated on first access
+    ///
+    /// For proxies obtained from a DataFrame, the concatenation is kept with
+    /// the table and shared by all later proxies of the same column
+    const std::shared_ptr<::arrow::Array> &data() const
+    {
+        if (data_ == nullptr && chunked_ != nullptr) {
+            if (combined_ != nullptr) {
+                data_ = std::atomic_load(&combined_->data);
+            }
+
+            if (data_ == nullptr) {
+                data_ = bind_array(chunked_->chunks());
+                if (combined_ != nullptr) {
+                    std::atomic_store(&combined_->data, data_);
+                }
+            }
+        }
+
+        return data_;
+    }
+
+    /// \brief The chunks of the column
+    ::arrow::ArrayVector chunks() const
+    {
+        if (chunked_ != nullptr) {
+            return chunked_->chunks();
+        }
+
+        if (data_ != nullptr) {
+            return {data_};
+        }
+
+        return {};
+    }
+
+    std::size_t nchunks() const
+    {
+        if (chunked_ != nullptr) {
+            return static_cast<std::size_t>(chunked_->num_chunks());
+        }
+
+        return data_ == nullptr ? 0 : 1;
+    }
+
+    std::shared_ptr<::arrow::DataType> type() const
+    {
+        if (chunked_ != nullptr) {
+            return chunked_->type();
+        }
+
+        return data_ == nullptr ? nullptr : data_->type();
+    }
 
     // attributes
 
     std::size_t size() const
     {
+        if (chunked_ != nullptr) {
+            return static_cast<std::size_t>(chunked_->length());
+        }
+
         if (data_ == nullptr) {
             return 0;
         }
@@ -180,36 +327,107 @@ class ConstColumnProxy
         return static_cast<std::size_t>(data_->length());
     }
 
+    std::size_t null_count() const
+    {
+        if (chunked_ != nullptr) {
+            return static_cast<std::size_t>(chunked_->null_count());
+        }
+
+        if (data_ == nullptr) {
+            return 0;
+        }
+
+        return static_cast<std::size_t>(data_->null_count());
+    }
+
+    /// \brief Statistics of the column, computed in one pass on first use
+    /// and cached for the data of the column until it is replaced
+    std::shared_ptr<const ColumnStats> stats() const
+    {
+        auto ret = cached_stats();
+        if (ret == nullptr) {
+            ret = std::make_shared<ColumnStats>(compute_stats(chunks()));
+            internal::StatsCache::instance().insert(stats_key(), ret);
+        }
+
+        return ret;
+    }
+
+    /// \brief Statistics of the column if they have been computed, otherwise
+    /// nullptr
+    std::shared_ptr<const ColumnStats> cached_stats() const
+    {
+        if (!*this) {
+            return nullptr;
+        }
+
+        return internal::StatsCache::instance().find(stats_key());
+    }
+
+    /// \brief Record known statistics of the column, such as those read back
+    /// by a serializer
+    void set_stats(ColumnStats stats) const
+    {
+        if (!*this) {
+            throw DataFrameException("Null column " + name_);
+        }
+
+        internal::StatsCache::instance().insert(
+            stats_key(), std::make_shared<ColumnStats>(std::move(stats)));
+    }
+
     // type information
 
+    /// \brief Bytes used by the column, a slice only counts the part of the
+    /// buffers it covers
     std::size_t memory_usage() const
     {
-        return data_ == nullptr ? 0 : memory_usage(*data_->data());
+        std::size_t ret = 0;
+        for (auto &&chunk : chunks()) {
+            ret += ::dataframe::memory_usage(*chunk);
+        }
+
+        return ret;
     }
 
   protected:
-    std::string name_;
-    std::shared_ptr<::arrow::Array> data_;
-
-  private:
-    static std::size_t memory_usage(const ::arrow::ArrayData &data)
+    std::shared_ptr<const void> stats_key() const
     {
-        std::size_t ret = 0;
+        if (chunked_ != nullptr) {
+            return chunked_;
+        }
 
-        for (auto &buf : data.buffers) {
-            if (buf != nullptr) {
-                ret += static_cast<std::size_t>(buf->size());
-            }
+        if (data_ == nullptr) {
+            throw DataFrameException("Null column " + name_);
         }
 
-        for (auto &child : data.child_data) {
-            if (child != nullptr) {
-                ret += memory_usage(*child);
-            }
+        return data_->data();
+    }
+
+    void set_chunks(std::shared_ptr<::arrow::ChunkedArray> chunks)
+    {
+        if (chunks == nullptr) {
+            return;
         }
 
-        return ret;
+        switch (chunks->num_chunks()) {
+            case 0:
+                DF_ARROW_ERROR_HANDLER(
+                    ::arrow::MakeArrayOfNull(chunks->type(), 0, &data_));
+                break;
+            case 1:
+                data_ = chunks->chunk(0);
+                break;
+            default:
+                chunked_ = std::move(chunks);
+                break;
+        }
     }
+
+    std::string name_;
+    mutable std::shared_ptr<::arrow::Array> data_;
+    std::shared_ptr<::arrow::ChunkedArray> chunked_;
+    std::shared_ptr<internal::CombinedChunks> combined_;
 };
 
 inline bool operator==(
@@ -223,11 +441,20 @@ inline bool operator==(
         return false;
     }
 
-    if (col1.data() == col2.data()) {
-        return true;
+    if (!col1 || !col2) {
+        return !col1 && !col2;
     }
 
-    return col1.data()->Equals(col2.data());
+    if (col1.nchunks() <= 1 && col2.nchunks() <= 1) {
+        if (col1.data() == col2.data()) {
+            return true;
+        }
+
+        return col1.data()->Equals(col2.data());
+    }
+
+    return ::arrow::ChunkedArray(col1.chunks(), col1.type())
+        .Equals(::arrow::ChunkedArray(col2.chunks(), col2.type()));
 }
 
 inline bool operator!=(
@@ -241,8 +468,19 @@ class ColumnProxy : public ConstColumnProxy
 {
   public:
     ColumnProxy(std::string name, std::shared_ptr<::arrow::Table> &table)
-        : ConstColumnProxy(name, table)
+        : ColumnProxy(name, table,
+              table == nullptr ? -1 : table->schema()->GetFieldIndex(name))
+    {
+    }
+
+    /// \brief Construct with the known position of the column in the table,
+    /// or a negative index for a new column
+    ColumnProxy(std::string name, std::shared_ptr<::arrow::Table> &table,
+        int index,
+        std::shared_ptr<internal::CombinedChunks> combined = nullptr)
+        : ConstColumnProxy(name, table, index, std::move(combined))
         , table_(table)
+        , index_(index)
     {
     }
 
@@ -261,6 +499,11 @@ class ColumnProxy : public ConstColumnProxy
     /// \brief Assign another column
     ColumnProxy &operator=(ConstColumnProxy col)
     {
+        if (col.nchunks() > 1) {
+            return operator=(std::make_shared<::arrow::ChunkedArray>(
+                col.chunks(), col.type()));
+        }
+
         return operator=(col.data());
     }
 
@@ -270,21 +513,37 @@ class ColumnProxy : public ConstColumnProxy
         return operator=(make_array<T>(vec));
     }
 
+    /// \brief Assign a vector of fixed-width values by taking over its
+    /// storage without copying
+    template <typename T, typename Alloc>
+    ColumnProxy &operator=(std::vector<T, Alloc> &&vec)
+    {
+        return operator=(make_array<T>(std::move(vec)));
+    }
+
+    /// \brief Assign a constant column, long columns are stored as chunks
+    /// sharing one block of values instead of being materialized
     template <typename T>
     ColumnProxy &operator=(Repeat<T> rep)
     {
+        auto length = static_cast<std::int64_t>(rep.size());
+
         if (table_ == nullptr) {
-            if (rep.size() > 0) {
-                return operator=(make_array<T>(rep.begin(), rep.end()));
-            } else {
+            if (rep.size() == 0) {
                 throw DataFrameException(
                     "Cannot assign a empty Repeat as the first column");
             }
         } else {
-            rep = repeat(
-                rep.front(), static_cast<std::size_t>(table_->num_rows()));
-            return operator=(make_array<T>(rep.begin(), rep.end()));
+            length = table_->num_rows();
+        }
+
+        if (length > run_block_size) {
+            return operator=(constant_array<T>(rep.front(), length));
         }
+
+        rep = repeat(rep.front(), static_cast<std::size_t>(length));
+
+        return operator=(make_array<T>(rep.begin(), rep.end()));
     }
 
     /// \brief Assign a pre-constructed Arrow array
@@ -295,34 +554,38 @@ class ColumnProxy : public ConstColumnProxy
                 "Cannot assign a null array to column " + name_);
         }
 
-        if (table_ != nullptr && table_->num_columns() != 0 &&
-            table_->num_rows() != data->length()) {
-            throw DataFrameException("Length of new column " + name_ + " (" +
-                std::to_string(data->length()) +
-                ") is not the same as the old columns (" +
-                std::to_string(table_->num_rows()) + ")");
-        }
+        check_length(data->length());
+        release_casts();
 
+        chunked_.reset();
+        combined_.reset();
         data_ = std::move(data);
         auto fld = ::arrow::field(name_, data_->type());
-        auto col = std::make_shared<::arrow::Column>(fld, data_);
+        assign(fld, std::make_shared<::arrow::Column>(fld, data_));
 
-        if (table_ == nullptr || table_->num_columns() == 0) {
-            std::vector<std::shared_ptr<::arrow::Field>> fields = {fld};
-            std::vector<std::shared_ptr<::arrow::Column>> columns = {col};
-            table_ = ::arrow::Table::Make(
-                std::make_shared<::arrow::Schema>(fields), columns);
-            return *this;
-        }
+        return *this;
+    }
 
-        auto index = static_cast<int>(table_->schema()->GetFieldIndex(name_));
-        if (index >= 0) {
-            DF_ARROW_ERROR_HANDLER(table_->SetColumn(index, col, &table_));
-        } else {
-            DF_ARROW_ERROR_HANDLER(
-                table_->AddColumn(table_->num_columns(), col, &table_));
+    /// \brief Assign a pre-constructed Arrow chunked array, the chunks are
+    /// kept as is
+    ColumnProxy &operator=(std::shared_ptr<::arrow::ChunkedArray> data)
+    {
+        if (data == nullptr) {
+            throw DataFrameException(
+                "Cannot assign a null array to column " + name_);
         }
 
+        check_length(data->length());
+        release_casts();
+
+        data_.reset();
+        chunked_.reset();
+        combined_.reset();
+        auto fld = ::arrow::field(name_, data->type());
+        auto col = std::make_shared<::arrow::Column>(fld, data);
+        set_chunks(std::move(data));
+        assign(fld, std::move(col));
+
         return *this;
     }
 
@@ -332,13 +595,14 @@ class ColumnProxy : public ConstColumnProxy
             throw DataFrameException("Empty DataFrame");
         }
 
-        auto index = static_cast<int>(table_->schema()->GetFieldIndex(name_));
+        auto index = find_index();
         if (index < 0) {
             throw DataFrameException("Column does not exist");
         }
 
-        auto fld = ::arrow::field(name, data_->type());
-        auto col = std::make_shared<::arrow::Column>(fld, data_);
+        auto fld = ::arrow::field(name, type());
+        auto col = std::make_shared<::arrow::Column>(
+            fld, table_->column(index)->data());
         DF_ARROW_ERROR_HANDLER(table_->SetColumn(index, col, &table_));
     }
 
@@ -348,16 +612,72 @@ class ColumnProxy : public ConstColumnProxy
             return;
         }
 
-        auto index = static_cast<int>(table_->schema()->GetFieldIndex(name_));
+        auto index = find_index();
         if (index < 0) {
             return;
         }
 
+        release_casts();
         DF_ARROW_ERROR_HANDLER(table_->RemoveColumn(index, &table_));
+        index_ = -1;
     }
 
   private:
+    void release_casts() const
+    {
+        if (*this) {
+            internal::CastCache::instance().erase(stats_key());
+        }
+    }
+
+    void check_length(std::int64_t length) const
+    {
+        if (table_ != nullptr && table_->num_columns() != 0 &&
+            table_->num_rows() != length) {
+            throw DataFrameException("Length of new column " + name_ + " (" +
+                std::to_string(length) +
+                ") is not the same as the old columns (" +
+                std::to_string(table_->num_rows()) + ")");
+        }
+    }
+
+    void assign(const std::shared_ptr<::arrow::Field> &fld,
+        std::shared_ptr<::arrow::Column> col)
+    {
+        if (table_ == nullptr || table_->num_columns() == 0) {
+            std::vector<std::shared_ptr<::arrow::Field>> fields = {fld};
+            std::vector<std::shared_ptr<::arrow::Column>> columns = {
+                std::move(col)};
+            table_ = ::arrow::Table::Make(
+                std::make_shared<::arrow::Schema>(fields), columns);
+            index_ = 0;
+            return;
+        }
+
+        auto index = find_index();
+        if (index >= 0) {
+            DF_ARROW_ERROR_HANDLER(table_->SetColumn(index, col, &table_));
+        } else {
+            index = table_->num_columns();
+            DF_ARROW_ERROR_HANDLER(table_->AddColumn(index, col, &table_));
+        }
+        index_ = index;
+    }
+
+    // The position given on construction is checked against the current
+    // table, which may have been changed through another proxy
+    int find_index()
+    {
+        if (index_ < 0 || index_ >= table_->num_columns() ||
+            table_->schema()->field(index_)->name() != name_) {
+            index_ = table_->schema()->GetFieldIndex(name_);
+        }
+
+        return index_;
+    }
+
     std::shared_ptr<::arrow::Table> &table_;
+    int index_ = -1;
 };
 
 } // namespace dataframe
@@ -18,9 +18,70 @@
 #define DATAFRAME_TABLE_DATA_FRAME_HPP
 
 #include <dataframe/table/column.hpp>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace dataframe {
 
+namespace internal {
+
+/// \brief Build a table from columns in order with a single schema
+inline std::shared_ptr<::arrow::Table> make_table(
+    const std::vector<ConstColumnProxy> &columns)
+{
+    if (columns.empty()) {
+        return nullptr;
+    }
+
+    auto nrow = columns.front().size();
+
+    std::unordered_set<std::string> names;
+    std::vector<std::shared_ptr<::arrow::Field>> fields;
+    std::vector<std::shared_ptr<::arrow::Column>> cols;
+    fields.reserve(columns.size());
+    cols.reserve(columns.size());
+
+    for (auto &&col : columns) {
+        if (!col) {
+            throw DataFrameException(
+                "Cannot construct DataFrame with null column " + col.name());
+        }
+
+        if (!names.insert(col.name()).second) {
+            throw DataFrameException("Duplicate column name " + col.name());
+        }
+
+        if (col.size() != nrow) {
+            throw DataFrameException("Length of column " + col.name() +
+                " (" + std::to_string(col.size()) +
+                ") is not the same as the other columns (" +
+                std::to_string(nrow) + ")");
+        }
+
+        auto type = col.type();
+        fields.push_back(::arrow::field(col.name(), type));
+        cols.push_back(std::make_shared<::arrow::Column>(fields.back(),
+            std::make_shared<::arrow::ChunkedArray>(col.chunks(), type)));
+    }
+
+    return ::arrow::Table::Make(::arrow::schema(std::move(fields)), cols,
+        static_cast<std::int64_t>(nrow));
+}
+
+/// \brief Column positions by name of a table, and the concatenation of
+/// the chunks of each column once it has been read contiguously
+///
+/// The concatenation is carried over to the index of a new table for the
+/// columns that it shares with the old one
+struct ColumnIndex {
+    std::weak_ptr<::arrow::Table> table;
+    std::unordered_map<std::string, int> index;
+    std::vector<std::shared_ptr<CombinedChunks>> combined;
+};
+
+} // namespace internal
+
 /// \brief DataFrame in C++
 class DataFrame
 {
@@ -33,11 +94,10 @@ class DataFrame
     DataFrame(const DataFrame &) = default;
     DataFrame &operator=(const DataFrame &) = default;
 
+    /// \brief Construct from a table, columns with multiple chunks are kept
+    /// as is
     explicit DataFrame(std::shared_ptr<::arrow::Table> &&table)
-        : table_(table == nullptr ?
-                  nullptr :
-                  (is_single_chunk(*table) ? std::move(table) :
-                                             copy_table(*table)))
+        : table_(std::move(table))
     {
     }
 
@@ -46,25 +106,49 @@ class DataFrame
     {
     }
 
+    /// \brief Construct from (name, array) pairs in order, the schema is
+    /// built once instead of once per column
+    explicit DataFrame(
+        const std::vector<std::pair<std::string,
+            std::shared_ptr<::arrow::Array>>> &columns)
+    {
+        std::vector<ConstColumnProxy> cols;
+        cols.reserve(columns.size());
+        for (auto &&kv : columns) {
+            cols.emplace_back(kv.first, kv.second);
+        }
+
+        table_ = internal::make_table(cols);
+    }
+
     ConstColumnProxy operator[](const std::string &name) const
     {
-        return ConstColumnProxy(name, table_);
+        auto index = column_index(name);
+
+        return ConstColumnProxy(name, table_, index, combined(index));
     }
 
     ColumnProxy operator[](std::string name)
     {
-        return ColumnProxy(std::move(name), table_);
+        auto index = column_index(name);
+
+        return ColumnProxy(std::move(name), table_, index, combined(index));
     }
 
     ConstColumnProxy operator[](size_type j) const
     {
-        return ConstColumnProxy(table_->column(static_cast<int>(j)));
+        auto index = static_cast<int>(j);
+
+        return ConstColumnProxy(table_->schema()->field(index)->name(),
+            table_, index, combined(index));
     }
 
     ColumnProxy operator[](size_type j)
     {
-        return ColumnProxy(
-            table_->column(static_cast<int>(j))->name(), table_);
+        auto index = static_cast<int>(j);
+
+        return ColumnProxy(table_->schema()->field(index)->name(), table_,
+            index, combined(index));
     }
 
     ConstColumnProxy at(size_type j) const
@@ -139,16 +223,103 @@ class DataFrame
             return DataFrame();
         }
 
-        DataFrame ret;
+        std::vector<ConstColumnProxy> columns;
         for (size_type k = begin; k != end; ++k) {
-            auto col = operator[](k);
-            ret[col.name()] = col.data();
+            columns.push_back(operator[](k));
         }
 
-        return ret;
+        return DataFrame(internal::make_table(columns));
+    }
+
+    /// \brief Whether any column consists of more than one chunk
+    bool is_chunked() const
+    {
+        return table_ != nullptr && !is_single_chunk(*table_);
+    }
+
+    /// \brief Concatenate the chunks of each column
+    DataFrame combine_chunks(
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool()) const
+    {
+        if (!is_chunked()) {
+            return *this;
+        }
+
+        std::shared_ptr<::arrow::Table> ret;
+        DF_ARROW_ERROR_HANDLER(table_->CombineChunks(pool, &ret));
+
+        return DataFrame(std::move(ret));
+    }
+
+    /// \brief The position of a column, or -1 if it does not exist
+    ///
+    /// The positions are hashed by name once per table and rebuilt only after
+    /// the columns change
+    int column_index(const std::string &name) const
+    {
+        if (table_ == nullptr) {
+            return -1;
+        }
+
+        auto index = column_map();
+        auto iter = index->index.find(name);
+
+        return iter == index->index.end() ? -1 : iter->second;
     }
 
   private:
+    std::shared_ptr<const internal::ColumnIndex> column_map() const
+    {
+        auto index = std::atomic_load(&index_);
+        if (index == nullptr || index->table.owner_before(table_) ||
+            table_.owner_before(index->table)) {
+            // Columns whose chunks are unchanged keep their concatenation
+            std::unordered_map<const ::arrow::ChunkedArray *,
+                std::shared_ptr<internal::CombinedChunks>>
+                prev;
+            if (index != nullptr) {
+                for (auto &slot : index->combined) {
+                    auto chunks = slot->chunks.lock();
+                    if (chunks != nullptr) {
+                        prev.emplace(chunks.get(), slot);
+                    }
+                }
+            }
+
+            auto ret = std::make_shared<internal::ColumnIndex>();
+            auto ncol = table_->num_columns();
+            ret->table = table_;
+            ret->index.reserve(static_cast<std::size_t>(ncol));
+            ret->combined.reserve(static_cast<std::size_t>(ncol));
+            for (auto i = 0; i != ncol; ++i) {
+                ret->index.emplace(table_->schema()->field(i)->name(), i);
+
+                auto chunks = table_->column(i)->data();
+                auto iter = prev.find(chunks.get());
+                if (iter != prev.end()) {
+                    ret->combined.push_back(iter->second);
+                } else {
+                    auto slot = std::make_shared<internal::CombinedChunks>();
+                    slot->chunks = chunks;
+                    ret->combined.push_back(std::move(slot));
+                }
+            }
+            index = std::move(ret);
+            std::atomic_store(&index_, index);
+        }
+
+        return index;
+    }
+
+    std::shared_ptr<internal::CombinedChunks> combined(int index) const
+    {
+        if (table_ == nullptr || index < 0) {
+            return nullptr;
+        }
+
+        return column_map()->combined[static_cast<std::size_t>(index)];
+    }
+
     static bool is_single_chunk(const ::arrow::Table &table)
     {
         for (auto i = 0; i != table.num_columns(); ++i) {
@@ -162,15 +333,18 @@ class DataFrame
     static std::shared_ptr<::arrow::Table> copy_table(
         const ::arrow::Table &table)
     {
-        std::shared_ptr<::arrow::Table> ret;
-        DF_ARROW_ERROR_HANDLER(
-            table.CombineChunks(::arrow::default_memory_pool(), &ret));
+        std::vector<std::shared_ptr<::arrow::Column>> columns;
+        for (auto i = 0; i != table.num_columns(); ++i) {
+            columns.push_back(table.column(i));
+        }
 
-        return ret;
+        return ::arrow::Table::Make(
+            table.schema(), columns, table.num_rows());
     }
 
   private:
     std::shared_ptr<::arrow::Table> table_;
+    mutable std::shared_ptr<const internal::ColumnIndex> index_;
 };
 
 inline bool operator==(const DataFrame &df1, const DataFrame &df2)
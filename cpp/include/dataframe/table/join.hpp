@@ -27,121 +27,102 @@ enum class JoinType { Inner, Outer, Left, Right, Semi, Anti };
 
 namespace internal {
 
-class JoinVisitor : public ::arrow::ArrayVisitor
+class JoinVisitor
 {
   public:
     std::shared_ptr<::arrow::Array> index;
     std::vector<std::int64_t> index1;
     std::vector<std::int64_t> index2;
 
-    explicit JoinVisitor(JoinType kind, std::shared_ptr<::arrow::Array> array2)
+    /// \brief Known distinct counts of the keys, zero if unknown, used to
+    /// size the hash tables
+    std::size_t ndv1 = 0;
+    std::size_t ndv2 = 0;
+
+    JoinVisitor(JoinType kind, std::shared_ptr<::arrow::Array> array2,
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
         : kind_(kind)
         , array2_(std::move(array2))
+        , pool_(pool)
     {
     }
 
-    ::arrow::Status Visit(const ::arrow::Int8Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int16Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int32Array &array) override
+    template <typename ArrowType>
+    ::arrow::Status operator()(
+        TypeTag<ArrowType> tag, const ::arrow::Array &array)
     {
-        return visit(array);
-    }
+        using ArrayType = typename decltype(tag)::array_type;
 
-    ::arrow::Status Visit(const ::arrow::Int64Array &array) override
-    {
-        return visit(array);
-    }
+        constexpr bool is_binary = std::is_same_v<ArrowType,
+                                       ::arrow::StringType> ||
+            std::is_same_v<ArrowType, ::arrow::BinaryType>;
 
-    ::arrow::Status Visit(const ::arrow::UInt8Array &array) override
-    {
-        return visit(array);
-    }
+        constexpr bool is_fixed_binary =
+            std::is_same_v<ArrowType, ::arrow::FixedSizeBinaryType>;
 
-    ::arrow::Status Visit(const ::arrow::UInt16Array &array) override
-    {
-        return visit(array);
-    }
+        if constexpr (is_value_type_v<ArrowType> || is_binary ||
+            is_fixed_binary) {
+            auto &array1 = static_cast<const ArrayType &>(array);
+            auto &array2 = static_cast<const ArrayType &>(*array2_);
 
-    ::arrow::Status Visit(const ::arrow::UInt32Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt64Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::FloatArray &array) override
-    {
-        return visit(array);
-    }
+            if (array1.null_count() != 0 || array2.null_count() != 0) {
+                return ::arrow::Status::Invalid(
+                    "Missing values in index columns");
+            }
 
-    ::arrow::Status Visit(const ::arrow::DoubleArray &array) override
-    {
-        return visit(array);
-    }
+            if constexpr (is_value_type_v<ArrowType>) {
+                // Half floats are matched by their bits
+                return visit<ArrayType>(array1.length(), array1.raw_values(),
+                    array2.length(), array2.raw_values());
+            } else {
+                auto get = [](auto &&a, auto i) {
+                    if constexpr (is_binary) {
+                        return a.GetView(i);
+                    } else {
+                        return ::arrow::util::string_view(
+                            reinterpret_cast<const char *>(a.GetValue(i)),
+                            static_cast<std::size_t>(a.byte_width()));
+                    }
+                };
 
-    ::arrow::Status Visit(const ::arrow::Date32Array &array) override
-    {
-        return visit(array);
-    }
+                auto view1 = views(array1, get);
+                auto view2 = views(array2, get);
 
-    ::arrow::Status Visit(const ::arrow::TimestampArray &array) override
-    {
-        return visit(array);
+                return visit<ArrayType>(
+                    static_cast<std::int64_t>(view1.size()), view1.data(),
+                    static_cast<std::int64_t>(view2.size()), view2.data());
+            }
+        } else {
+            return ::arrow::Status::NotImplemented(
+                "Cannot join by ", array.type()->ToString());
+        }
     }
 
-    ::arrow::Status Visit(const ::arrow::StringArray &array1) override
+  private:
+    template <typename ArrayType, typename Get>
+    static std::vector<::arrow::util::string_view> views(
+        const ArrayType &array, Get &&get)
     {
-        const auto &array2 =
-            *std::static_pointer_cast<::arrow::StringArray>(array2_);
-
-        if (array1.null_count() != 0 || array2.null_count() != 0) {
-            return ::arrow::Status::Invalid("Missing values in index columns");
+        auto n = array.length();
+        std::vector<::arrow::util::string_view> ret;
+        ret.reserve(static_cast<std::size_t>(n));
+        for (std::int64_t i = 0; i != n; ++i) {
+            ret.emplace_back(get(array, i));
         }
 
-        auto view = [](auto &&array) {
-            auto n = array.length();
-            std::vector<std::remove_cv_t<
-                std::remove_reference_t<decltype(array.GetView(0))>>>
-                ret;
-            ret.reserve(static_cast<std::size_t>(n));
-            for (std::int64_t i = 0; i != n; ++i) {
-                ret.emplace_back(array.GetView(i));
-            }
-
-            return ret;
-        };
-
-        auto view1 = view(array1);
-        auto view2 = view(array2);
-
-        return visit<::arrow::StringArray>(
-            static_cast<std::int64_t>(view1.size()), view1.data(),
-            static_cast<std::int64_t>(view2.size()), view2.data());
+        return ret;
     }
 
-  private:
-    template <typename ArrayType>
-    ::arrow::Status visit(const ArrayType &array1)
+    template <typename Builder, typename T>
+    static ::arrow::Status append(Builder &builder, const T &value)
     {
-        const auto &array2 = *std::static_pointer_cast<ArrayType>(array2_);
-
-        if (array1.null_count() != 0 || array2.null_count() != 0) {
-            return ::arrow::Status::Invalid("Missing values in index columns");
+        if constexpr (std::is_same_v<Builder,
+                          ::arrow::FixedSizeBinaryBuilder>) {
+            return builder.Append(
+                reinterpret_cast<const std::uint8_t *>(value.data()));
+        } else {
+            return builder.Append(value);
         }
-
-        return visit<ArrayType>(array1.length(), array1.raw_values(),
-            array2.length(), array2.raw_values());
     }
 
     template <typename ArrayType, typename T>
@@ -149,8 +130,7 @@ class JoinVisitor : public ::arrow::ArrayVisitor
         std::int64_t n1, const T *v1, std::int64_t n2, const T *v2)
     {
         typename ::arrow::TypeTraits<typename ArrayType::TypeClass>::
-            BuilderType builder(
-                array2_->type(), ::arrow::default_memory_pool());
+            BuilderType builder(array2_->type(), pool_);
 
         switch (kind_) {
             case JoinType::Inner:
@@ -173,8 +153,10 @@ class JoinVisitor : public ::arrow::ArrayVisitor
                 break;
         }
 
-        auto idx = [](auto &&n, auto &&v) {
+        auto idx = [](auto &&n, auto &&v, std::size_t ndv) {
             std::unordered_map<T, std::int64_t> ret;
+            // The estimate may fall short by a few percent
+            ret.reserve(ndv + ndv / 16);
             for (std::int64_t i = 0; i != n; ++i) {
                 ret.emplace(v[i], i);
             }
@@ -183,24 +165,24 @@ class JoinVisitor : public ::arrow::ArrayVisitor
 
         switch (kind_) {
             case JoinType::Inner: {
-                auto idx2 = idx(n2, v2);
+                auto idx2 = idx(n2, v2, ndv2);
                 for (std::int64_t i = 0; i != n1; ++i) {
                     auto iter = idx2.find(v1[i]);
                     if (iter != idx2.end()) {
-                        ARROW_RETURN_NOT_OK(builder.Append(v1[i]));
+                        ARROW_RETURN_NOT_OK(append(builder, v1[i]));
                         index1.emplace_back(i);
                         index2.emplace_back(iter->second);
                     }
                 }
             } break;
             case JoinType::Outer: {
-                auto idx2 = idx(n2, v2);
+                auto idx2 = idx(n2, v2, ndv2);
                 std::vector<std::int64_t> only1;
 
                 for (std::int64_t i = 0; i != n1; ++i) {
                     auto iter = idx2.find(v1[i]);
                     if (iter != idx2.end()) {
-                        ARROW_RETURN_NOT_OK(builder.Append(v1[i]));
+                        ARROW_RETURN_NOT_OK(append(builder, v1[i]));
                         index1.emplace_back(i);
                         index2.emplace_back(iter->second);
                         idx2.erase(iter);
@@ -210,7 +192,7 @@ class JoinVisitor : public ::arrow::ArrayVisitor
                 }
 
                 for (auto &&i : only1) {
-                    ARROW_RETURN_NOT_OK(builder.Append(v1[i]));
+                    ARROW_RETURN_NOT_OK(append(builder, v1[i]));
                     index1.emplace_back(i);
                     index2.emplace_back(-1);
                 }
@@ -222,16 +204,16 @@ class JoinVisitor : public ::arrow::ArrayVisitor
                 std::sort(only2.begin(), only2.end());
 
                 for (auto &&i : only2) {
-                    ARROW_RETURN_NOT_OK(builder.Append(v2[i]));
+                    ARROW_RETURN_NOT_OK(append(builder, v2[i]));
                     index1.emplace_back(-1);
                     index2.emplace_back(i);
                 }
             } break;
             case JoinType::Left: {
-                auto idx2 = idx(n2, v2);
+                auto idx2 = idx(n2, v2, ndv2);
                 for (std::int64_t i = 0; i != n1; ++i) {
                     auto iter = idx2.find(v1[i]);
-                    ARROW_RETURN_NOT_OK(builder.Append(v1[i]));
+                    ARROW_RETURN_NOT_OK(append(builder, v1[i]));
                     index1.emplace_back(i);
                     if (iter != idx2.end()) {
                         index2.emplace_back(iter->second);
@@ -241,10 +223,10 @@ class JoinVisitor : public ::arrow::ArrayVisitor
                 }
             } break;
             case JoinType::Right: {
-                auto idx1 = idx(n1, v1);
+                auto idx1 = idx(n1, v1, ndv1);
                 for (std::int64_t i = 0; i != n2; ++i) {
                     auto iter = idx1.find(v2[i]);
-                    ARROW_RETURN_NOT_OK(builder.Append(v2[i]));
+                    ARROW_RETURN_NOT_OK(append(builder, v2[i]));
                     index2.emplace_back(i);
                     if (iter != idx1.end()) {
                         index1.emplace_back(iter->second);
@@ -254,21 +236,21 @@ class JoinVisitor : public ::arrow::ArrayVisitor
                 }
             } break;
             case JoinType::Semi: {
-                auto idx2 = idx(n2, v2);
+                auto idx2 = idx(n2, v2, ndv2);
                 for (std::int64_t i = 0; i != n1; ++i) {
                     auto iter = idx2.find(v1[i]);
                     if (iter != idx2.end()) {
-                        ARROW_RETURN_NOT_OK(builder.Append(v1[i]));
+                        ARROW_RETURN_NOT_OK(append(builder, v1[i]));
                         index1.emplace_back(i);
                     }
                 }
             } break;
             case JoinType::Anti: {
-                auto idx2 = idx(n2, v2);
+                auto idx2 = idx(n2, v2, ndv2);
                 for (std::int64_t i = 0; i != n1; ++i) {
                     auto iter = idx2.find(v1[i]);
                     if (iter == idx2.end()) {
-                        ARROW_RETURN_NOT_OK(builder.Append(v1[i]));
+                        ARROW_RETURN_NOT_OK(append(builder, v1[i]));
                         index1.emplace_back(i);
                     }
                 }
@@ -281,6 +263,7 @@ class JoinVisitor : public ::arrow::ArrayVisitor
   private:
     JoinType kind_;
     std::shared_ptr<::arrow::Array> array2_;
+    ::arrow::MemoryPool *pool_;
 };
 
 } // namespace internal
@@ -288,7 +271,8 @@ class JoinVisitor : public ::arrow::ArrayVisitor
 /// \brief Only include rows with keys that match in both `df1` and `df2`
 inline DataFrame join(const DataFrame &df1, const DataFrame &df2,
     const std::string &key, JoinType kind = JoinType::Inner,
-    bool make_unique = false)
+    bool make_unique = false,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
     if (!df1[key]) {
         throw DataFrameException(
@@ -300,7 +284,7 @@ inline DataFrame join(const DataFrame &df1, const DataFrame &df2,
             "key " + key + " does not exist on right DataFrame");
     }
 
-    if (!df1[key].data()->type()->Equals(*df2[key].data()->type())) {
+    if (!df1[key].type()->Equals(*df2[key].type())) {
         throw DataFrameException("key " + key + " has different type");
     }
 
@@ -318,31 +302,60 @@ inline DataFrame join(const DataFrame &df1, const DataFrame &df2,
         }
     }
 
-    auto data1 = df1[key].data();
-    auto data2 = df2[key].data();
-    internal::JoinVisitor visitor(kind, data2);
-    DF_ARROW_ERROR_HANDLER(data1->Accept(&visitor));
+    auto data1 = bind_array(df1[key].chunks(), pool);
+    auto data2 = bind_array(df2[key].chunks(), pool);
+    internal::JoinVisitor visitor(kind, data2, pool);
+    if (auto stats = df1[key].cached_stats()) {
+        visitor.ndv1 = stats->ndv;
+    }
+    if (auto stats = df2[key].cached_stats()) {
+        visitor.ndv2 = stats->ndv;
+    }
+    DF_ARROW_ERROR_HANDLER(visit_type(data1->type_id(),
+        [&](auto tag) { return visitor(tag, *data1); }));
 
     DataFrame index;
     index[key] = visitor.index;
 
-    auto ret1 = select(df1, visitor.index1.begin(), visitor.index1.end());
-    auto ret2 = select(df2, visitor.index2.begin(), visitor.index2.end());
-    ret1[key].remove();
-    ret2[key].remove();
+    // Select the remaining columns directly, so each side builds its schema
+    // once
+    auto select_columns = [&](auto &&df, auto &&idx) {
+        std::vector<ConstColumnProxy> ret;
+        auto ncol = df.ncol();
+        for (std::size_t i = 0; i != ncol; ++i) {
+            auto col = df[i];
+            if (col.name() != key) {
+                ret.emplace_back(col.name(),
+                    select_array(
+                        col.chunks(), idx.begin(), idx.end(), pool));
+            }
+        }
+        return ret;
+    };
+
+    auto cols1 = select_columns(df1, visitor.index1);
+    auto cols2 = left_only ? std::vector<ConstColumnProxy>() :
+                             select_columns(df2, visitor.index2);
 
     if (make_unique && !left_only) {
-        auto ncol1 = ret1.ncol();
-        for (std::size_t i = 0; i != ncol1; ++i) {
-            auto col1 = ret1[i];
-            auto col2 = ret2[col1.name()];
-            if (col2) {
-                col1.rename(col1.name() + "_1");
-                col2.rename(col2.name() + "_2");
+        std::unordered_map<std::string, std::size_t> names;
+        for (std::size_t i = 0; i != cols2.size(); ++i) {
+            names.emplace(cols2[i].name(), i);
+        }
+
+        for (auto &col1 : cols1) {
+            auto iter = names.find(col1.name());
+            if (iter != names.end()) {
+                auto &col2 = cols2[iter->second];
+                col1 = ConstColumnProxy(col1.name() + "_1", col1.data());
+                col2 = ConstColumnProxy(col2.name() + "_2", col2.data());
             }
         }
     }
 
+    DataFrame ret1(internal::make_table(cols1));
+    DataFrame ret2(internal::make_table(cols2));
+
     return bind_cols({index, ret1, ret2});
 }
 
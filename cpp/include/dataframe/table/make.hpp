@@ -17,7 +17,10 @@
 #ifndef DATAFRAME_TABLE_MAKE_HPP
 #define DATAFRAME_TABLE_MAKE_HPP
 
-#include <dataframe/table/data_frame.hpp>
+#include <dataframe/table/bind.hpp>
+#include <arrow/util/parallel.h>
+#include <algorithm>
+#include <tuple>
 
 #define DF_FIELD_PAIR(T, field) std::make_pair(#field, &T::field)
 
@@ -25,28 +28,132 @@ namespace dataframe {
 
 namespace internal {
 
-template <typename Iter>
-inline void make_column(DataFrame &, Iter, Iter)
+template <typename Iter, typename Member>
+inline auto make_member_iterator(Iter iter, Member member)
 {
+    if constexpr (std::is_member_object_pointer_v<Member>) {
+        using R = decltype((*iter).*member);
+        using V = std::remove_cv_t<std::remove_reference_t<R>>;
+        return MemberObjectIterator<V, R, Iter, Member>(iter, member);
+    } else if constexpr (std::is_member_function_pointer_v<Member>) {
+        using R = decltype(((*iter).*member)());
+        using V = std::remove_cv_t<std::remove_reference_t<R>>;
+        return MemberFunctionIterator<V, R, Iter, Member>(iter, member);
+    } else {
+        using R = decltype(member(*iter));
+        using V = std::remove_cv_t<std::remove_reference_t<R>>;
+        return MemberGetterIterator<V, R, Iter, Member>(iter, member);
+    }
 }
 
-template <typename Iter, typename K, typename V, typename... Args>
-inline void make_column(DataFrame &ret, Iter first, Iter last,
-    const std::pair<K, V> &kv, Args &&... args)
+/// \brief Builder of a single column from one member of the records
+template <typename Iter, typename Member>
+class ColumnMaker
 {
-    ret[kv.first].emplace(first, last, kv.second);
-    make_column(ret, first, last, std::forward<Args>(args)...);
+  public:
+    using value_type = typename decltype(make_member_iterator(
+        std::declval<Iter>(), std::declval<Member>()))::value_type;
+
+    ColumnMaker(std::string name, Member member, ::arrow::MemoryPool *pool)
+        : name_(std::move(name))
+        , member_(member)
+        , pool_(pool)
+        , builder_(make_builder<value_type>(pool))
+    {
+    }
+
+    void reserve(std::int64_t n)
+    {
+        DF_ARROW_ERROR_HANDLER(builder_->Reserve(n));
+    }
+
+    void append(Iter first, Iter last)
+    {
+        ArrayMaker<value_type>::append(builder_.get(),
+            make_member_iterator(first, member_),
+            make_member_iterator(last, member_));
+    }
+
+    std::pair<std::string, std::shared_ptr<::arrow::Array>> finish()
+    {
+        std::shared_ptr<::arrow::Array> ret;
+        DF_ARROW_ERROR_HANDLER(builder_->Finish(&ret));
+
+        return {std::move(name_), cast_array<value_type>(ret, pool_)};
+    }
+
+  private:
+    std::string name_;
+    Member member_;
+    ::arrow::MemoryPool *pool_;
+    std::unique_ptr<BuilderType<value_type>> builder_;
+};
+
+/// \brief Convert records into columns in a single pass
+///
+/// The records are walked in blocks small enough to stay in cache, and each
+/// block is appended to all columns before moving on to the next one
+template <typename Iter, typename... Args>
+inline DataFrame make_rows(
+    ::arrow::MemoryPool *pool, Iter first, Iter last, const Args &... args)
+{
+    using category = typename std::iterator_traits<Iter>::iterator_category;
+    using record = typename std::iterator_traits<Iter>::value_type;
+
+    constexpr std::ptrdiff_t block_bytes = 1 << 16;
+    constexpr auto block = std::max<std::ptrdiff_t>(
+        1, block_bytes / static_cast<std::ptrdiff_t>(sizeof(record)));
+
+    std::tuple<ColumnMaker<Iter, typename Args::second_type>...> makers(
+        ColumnMaker<Iter, typename Args::second_type>(
+            args.first, args.second, pool)...);
+
+    auto n = static_cast<std::int64_t>(std::distance(first, last));
+    std::apply([&](auto &... m) { (m.reserve(n), ...); }, makers);
+
+    auto iter = first;
+    while (iter != last) {
+        auto next = iter;
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                          category>) {
+            next += std::min<std::ptrdiff_t>(block, last - iter);
+        } else {
+            for (std::ptrdiff_t k = 0; k != block && next != last; ++k) {
+                ++next;
+            }
+        }
+
+        std::apply(
+            [&](auto &... m) { (m.append(iter, next), ...); }, makers);
+        iter = next;
+    }
+
+    return DataFrame(std::apply(
+        [](auto &... m) {
+            return std::vector<
+                std::pair<std::string, std::shared_ptr<::arrow::Array>>>{
+                m.finish()...};
+        },
+        makers));
 }
 
 } // namespace internal
 
+/// \brief Make a DataFrame from records with column buffers allocated from
+/// `pool`, each argument is a pair of a column name and a member pointer or
+/// getter as made by `DF_FIELD_PAIR`
 template <typename Iter, typename... Args>
-inline DataFrame make_dataframe(Iter first, Iter last, Args &&... args)
+inline DataFrame make_dataframe(
+    ::arrow::MemoryPool *pool, Iter first, Iter last, Args &&... args)
 {
-    DataFrame ret;
-    internal::make_column(ret, first, last, std::forward<Args>(args)...);
+    return internal::make_rows(pool, first, last, args...);
+}
 
-    return ret;
+template <typename Iter, typename... Args>
+inline DataFrame make_dataframe(Iter first, Iter last, Args &&... args)
+{
+    return make_dataframe(::arrow::default_memory_pool(), first, last,
+        std::forward<Args>(args)...);
 }
 
 template <typename T, typename Alloc, typename... Args>
@@ -62,6 +169,56 @@ inline DataFrame make_dataframe(std::size_t n, const T *data, Args &&... args)
     return make_dataframe(data, data + n, std::forward<Args>(args)...);
 }
 
+/// \brief Make a DataFrame from records by converting row ranges on the CPU
+/// thread pool and concatenating the results
+///
+/// Falls back to a single pass on the calling thread when there are too few
+/// records to be worth splitting
+template <typename Iter, typename... Args>
+inline DataFrame make_dataframe_parallel(
+    ::arrow::MemoryPool *pool, Iter first, Iter last, Args &&... args)
+{
+    static_assert(std::is_base_of_v<std::random_access_iterator_tag,
+                      typename std::iterator_traits<Iter>::iterator_category>,
+        "make_dataframe_parallel requires random access iterators");
+
+    constexpr std::ptrdiff_t min_rows = 1 << 16;
+
+    auto n = last - first;
+    auto nparts = std::min<std::ptrdiff_t>(
+        ::arrow::GetCpuThreadPoolCapacity(), n / min_rows);
+
+    if (nparts <= 1) {
+        return internal::make_rows(pool, first, last, args...);
+    }
+
+    std::vector<DataFrame> parts(static_cast<std::size_t>(nparts));
+    DF_ARROW_ERROR_HANDLER(::arrow::internal::ParallelFor(
+        static_cast<int>(nparts), [&](int i) {
+            auto k = static_cast<std::ptrdiff_t>(i);
+            auto begin = first + n * k / nparts;
+            auto end = first + n * (k + 1) / nparts;
+            try {
+                parts[static_cast<std::size_t>(i)] =
+                    internal::make_rows(pool, begin, end, args...);
+            } catch (const std::exception &e) {
+                return ::arrow::Status::Invalid(e.what());
+            }
+
+            return ::arrow::Status::OK();
+        }));
+
+    return bind_rows(parts, pool);
+}
+
+template <typename T, typename Alloc, typename... Args>
+inline DataFrame make_dataframe_parallel(
+    const std::vector<T, Alloc> &vec, Args &&... args)
+{
+    return make_dataframe_parallel(::arrow::default_memory_pool(),
+        vec.begin(), vec.end(), std::forward<Args>(args)...);
+}
+
 } // namespace dataframe
 
 #endif // DATAFRAME_TABLE_MAKE_HPP
@@ -0,0 +1,134 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_TABLE_MEMORY_HPP
+#define DATAFRAME_TABLE_MEMORY_HPP
+
+#include <dataframe/memory_pool.hpp>
+#include <dataframe/table/data_frame.hpp>
+#include <optional>
+
+namespace dataframe {
+
+/// \brief Memory used by a set of DataFrames
+struct MemoryReport {
+    struct PoolUsage {
+        ::arrow::MemoryPool *pool = nullptr;
+
+        /// \brief Bytes currently allocated from the pool
+        std::int64_t bytes_allocated = 0;
+
+        /// \brief Peak bytes allocated from the pool
+        std::int64_t max_memory = 0;
+
+        /// \brief Bytes of `unique_bytes` allocated from the pool, known
+        /// only for an `ArenaMemoryPool`
+        std::optional<std::size_t> frame_bytes;
+    };
+
+    /// \brief Sum of the full size of every buffer referenced, a buffer
+    /// shared by several columns or slices is counted each time
+    std::size_t buffer_bytes = 0;
+
+    /// \brief Bytes covered by the columns, a slice only counts its part of
+    /// the buffers
+    std::size_t slice_bytes = 0;
+
+    /// \brief Bytes of the distinct allocations referenced, each counted once
+    /// no matter how many columns, slices or frames share it
+    std::size_t unique_bytes = 0;
+
+    /// \brief Usage of each pool given to `memory_report`
+    std::vector<PoolUsage> pools;
+};
+
+/// \brief Report the memory used by a set of DataFrames
+///
+/// Arrow buffers do not record the pool that allocated them. The bytes of
+/// the frames are attributed to an `ArenaMemoryPool` by the addresses of its
+/// slabs, other pools only report their global current and peak usage
+inline MemoryReport memory_report(const std::vector<DataFrame> &dfs,
+    const std::vector<::arrow::MemoryPool *> &pools = {
+        ::arrow::default_memory_pool()})
+{
+    MemoryReport ret;
+    std::unordered_map<const std::uint8_t *, std::int64_t> buffers;
+
+    auto count_buffers = [&](const std::shared_ptr<::arrow::ArrayData> &data,
+                             auto &&self) -> void {
+        for (auto &&buf : data->buffers) {
+            if (buf != nullptr) {
+                ret.buffer_bytes += static_cast<std::size_t>(buf->size());
+            }
+        }
+        for (auto &&child : data->child_data) {
+            self(child, self);
+        }
+        if (data->type->id() == ::arrow::Type::DICTIONARY) {
+            self(::arrow::DictionaryArray(data).dictionary()->data(), self);
+        }
+    };
+
+    for (auto &&df : dfs) {
+        auto ncol = df.ncol();
+        for (std::size_t i = 0; i != ncol; ++i) {
+            auto col = df[i];
+            ret.slice_bytes += col.memory_usage();
+            for (auto &&chunk : col.chunks()) {
+                count_buffers(chunk->data(), count_buffers);
+                internal::collect_buffers(chunk->data(), buffers);
+            }
+        }
+    }
+
+    for (auto &&buf : buffers) {
+        ret.unique_bytes += static_cast<std::size_t>(buf.second);
+    }
+
+    for (auto pool : pools) {
+        if (pool != nullptr) {
+            MemoryReport::PoolUsage usage;
+            usage.pool = pool;
+            usage.bytes_allocated = pool->bytes_allocated();
+            usage.max_memory = pool->max_memory();
+
+            if (auto arena = dynamic_cast<ArenaMemoryPool *>(pool)) {
+                std::size_t bytes = 0;
+                for (auto &&buf : buffers) {
+                    if (arena->owns(buf.first)) {
+                        bytes += static_cast<std::size_t>(buf.second);
+                    }
+                }
+                usage.frame_bytes = bytes;
+            }
+
+            ret.pools.push_back(usage);
+        }
+    }
+
+    return ret;
+}
+
+inline MemoryReport memory_report(const DataFrame &df,
+    const std::vector<::arrow::MemoryPool *> &pools = {
+        ::arrow::default_memory_pool()})
+{
+    return memory_report(std::vector<DataFrame>{df}, pools);
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_TABLE_MEMORY_HPP
@@ -0,0 +1,57 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_TABLE_RUNS_HPP
+#define DATAFRAME_TABLE_RUNS_HPP
+
+#include <dataframe/table/data_frame.hpp>
+
+namespace dataframe {
+
+/// \brief Store columns with at most `max_runs` runs of equal values, such
+/// as sorted low cardinality columns, as runs of chunks sharing a block of
+/// values. Other columns are kept as is
+///
+/// The encoded columns work with all operations on chunked columns and are
+/// only expanded when contiguous data is requested. Columns whose runs are
+/// mostly shorter than `block_size` are kept as is
+inline DataFrame encode_runs(const DataFrame &df, std::size_t max_runs = 64,
+    std::int64_t block_size = run_block_size,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    std::vector<ConstColumnProxy> columns;
+
+    auto ncol = df.ncol();
+    for (std::size_t i = 0; i != ncol; ++i) {
+        auto col = df[i];
+        auto chunks = col.chunks();
+        auto runs = chunks.empty() ?
+            nullptr :
+            encode_runs(chunks, max_runs, block_size, pool);
+
+        if (runs == nullptr) {
+            columns.push_back(col);
+        } else {
+            columns.emplace_back(col.name(), runs);
+        }
+    }
+
+    return DataFrame(internal::make_table(columns));
+}
+
+} // namespace dataframe
+
+#endif // DATAFRAME_TABLE_RUNS_HPP
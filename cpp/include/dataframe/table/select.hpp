@@ -23,21 +23,25 @@
 namespace dataframe {
 
 template <typename Iter>
-inline DataFrame select(const DataFrame &df, Iter first, Iter last)
+inline DataFrame select(const DataFrame &df, Iter first, Iter last,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
-    DataFrame ret;
+    std::vector<ConstColumnProxy> columns;
     auto ncol = df.ncol();
+    columns.reserve(ncol);
     for (std::size_t i = 0; i != ncol; ++i) {
         auto col = df[i];
-        ret[col.name()] = select_array(col.data(), first, last);
+        columns.emplace_back(
+            col.name(), select_array(col.chunks(), first, last, pool));
     }
 
-    return ret;
+    return DataFrame(internal::make_table(columns));
 }
 
 template <typename Alloc>
-inline DataFrame select(
-    const DataFrame &df, const std::vector<bool, Alloc> &mask)
+inline DataFrame select(const DataFrame &df,
+    const std::vector<bool, Alloc> &mask,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
     if (df.nrow() != mask.size()) {
         throw DataFrameException("mask does not have the correct size");
@@ -50,7 +54,33 @@ inline DataFrame select(
         }
     }
 
-    return select(df, index.begin(), index.end());
+    return select(df, index.begin(), index.end(), pool);
+}
+
+/// \brief Select the rows where a boolean mask is true, null elements of the
+/// mask count as false
+inline DataFrame select(const DataFrame &df, const ArrayView<bool> &mask,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    if (df.nrow() != mask.size()) {
+        throw DataFrameException("mask does not have the correct size");
+    }
+
+    std::vector<std::int64_t> index;
+    index.reserve(mask.count());
+
+    auto nwords = mask.nwords();
+    for (std::size_t k = 0; k != nwords; ++k) {
+        auto w = mask.set_word(k);
+        auto base = static_cast<std::int64_t>(k * 64);
+        while (w != 0) {
+            index.push_back(
+                base + ::arrow::BitUtil::CountTrailingZeros(w));
+            w &= w - 1;
+        }
+    }
+
+    return select(df, index.begin(), index.end(), pool);
 }
 
 } // namespace dataframe
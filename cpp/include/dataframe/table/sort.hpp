@@ -18,139 +18,124 @@
 #define DATAFRAME_TABLE_SORT_HPP
 
 #include <dataframe/table/select.hpp>
+#include <algorithm>
 
 namespace dataframe {
 
 namespace internal {
 
-class SortVisitor : public ::arrow::ArrayVisitor
+class SortVisitor
 {
   public:
     std::vector<std::int64_t> index;
 
-    explicit SortVisitor(bool rev)
-        : rev_(rev)
+    SortVisitor(const ::arrow::ArrayVector &chunks, bool rev)
+        : chunks_(chunks)
+        , rev_(rev)
     {
     }
 
-    ::arrow::Status Visit(const ::arrow::Int8Array &array) override
+    template <typename ArrowType>
+    ::arrow::Status operator()(TypeTag<ArrowType> tag)
     {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int16Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int32Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int64Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt8Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt16Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt32Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt64Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::FloatArray &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::DoubleArray &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Date32Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::TimestampArray &array) override
-    {
-        return visit(array);
+        using ArrayType = typename decltype(tag)::array_type;
+
+        if constexpr (std::is_same_v<ArrowType, ::arrow::HalfFloatType>) {
+            return visit<ArrayType>([](auto &&array, auto i) {
+                return half_to_float(array.Value(i));
+            });
+        } else if constexpr (std::is_same_v<ArrowType,
+                                 ::arrow::FixedSizeBinaryType>) {
+            return visit<ArrayType>([](auto &&array, auto i) {
+                return ::arrow::util::string_view(
+                    reinterpret_cast<const char *>(array.GetValue(i)),
+                    static_cast<std::size_t>(array.byte_width()));
+            });
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::StringType> ||
+            std::is_same_v<ArrowType, ::arrow::BinaryType>) {
+            return visit<ArrayType>(
+                [](auto &&array, auto i) { return array.GetView(i); });
+        } else if constexpr (is_value_type_v<ArrowType> ||
+            std::is_same_v<ArrowType, ::arrow::BooleanType>) {
+            return visit<ArrayType>(
+                [](auto &&array, auto i) { return array.Value(i); });
+        } else {
+            return ::arrow::Status::NotImplemented(
+                "Cannot sort by ", chunks_.front()->type()->ToString());
+        }
     }
 
-    ::arrow::Status Visit(const ::arrow::StringArray &array) override
+  private:
+    // Sort the logical concatenation of the chunks, the keys of multiple
+    // chunks are gathered once so that comparisons do not locate chunks
+    template <typename ArrayType, typename Get>
+    ::arrow::Status visit(Get &&get)
     {
-        if (array.null_count() != 0) {
-            return ::arrow::Status::Invalid(
-                "Cannot sort array with missing values");
+        std::int64_t n = 0;
+        for (auto &&chunk : chunks_) {
+            if (chunk->null_count() != 0) {
+                return ::arrow::Status::Invalid(
+                    "Cannot sort array with missing values");
+            }
+            n += chunk->length();
         }
 
-        auto n = array.length();
-
         index.reserve(static_cast<std::size_t>(n));
         for (std::int64_t i = 0; i != n; ++i) {
             index.push_back(i);
         }
 
-        if (rev_) {
-            std::stable_sort(
-                index.begin(), index.end(), [&](auto &&i1, auto &&i2) {
-                    return array.GetView(i1) > array.GetView(i2);
-                });
+        if (chunks_.size() == 1) {
+            auto &array = static_cast<const ArrayType &>(*chunks_.front());
+            sort([&](auto i) { return get(array, i); });
         } else {
-            std::stable_sort(
-                index.begin(), index.end(), [&](auto &&i1, auto &&i2) {
-                    return array.GetView(i1) < array.GetView(i2);
-                });
+            using Key = std::decay_t<decltype(
+                get(std::declval<const ArrayType &>(), std::int64_t()))>;
+
+            std::vector<Key> keys;
+            keys.reserve(static_cast<std::size_t>(n));
+            for (auto &&chunk : chunks_) {
+                auto &array = static_cast<const ArrayType &>(*chunk);
+                auto len = array.length();
+                for (std::int64_t i = 0; i != len; ++i) {
+                    keys.push_back(get(array, i));
+                }
+            }
+
+            sort([&](auto i) { return keys[static_cast<std::size_t>(i)]; });
         }
 
         return ::arrow::Status::OK();
     }
 
-  private:
-    template <typename ArrayType>
-    ::arrow::Status visit(const ArrayType &array)
+    template <typename T>
+    static bool is_nan(const T &v)
     {
-        if (array.null_count() != 0) {
-            return ::arrow::Status::Invalid(
-                "Cannot sort array with missing values");
-        }
-
-        auto n = array.length();
-        auto v = array.raw_values();
-
-        index.reserve(static_cast<std::size_t>(n));
-        for (std::int64_t i = 0; i != n; ++i) {
-            index.push_back(i);
-        }
-
-        if (rev_) {
-            std::stable_sort(index.begin(), index.end(),
-                [&](auto &&i1, auto &&i2) { return v[i1] > v[i2]; });
+        if constexpr (std::is_floating_point_v<T>) {
+            return v != v;
         } else {
-            std::stable_sort(index.begin(), index.end(),
-                [&](auto &&i1, auto &&i2) { return v[i1] < v[i2]; });
+            return false;
         }
+    }
 
-        return ::arrow::Status::OK();
+    // NaN compares unordered with all values, it is placed last in either
+    // direction so that the order is strict weak
+    template <typename Value>
+    void sort(Value &&value)
+    {
+        std::stable_sort(
+            index.begin(), index.end(), [&](auto &&i1, auto &&i2) {
+                auto v1 = value(i1);
+                auto v2 = value(i2);
+                if (is_nan(v1) || is_nan(v2)) {
+                    return !is_nan(v1) && is_nan(v2);
+                }
+                return rev_ ? v2 < v1 : v1 < v2;
+            });
     }
 
   private:
+    const ::arrow::ArrayVector &chunks_;
     bool rev_;
 };
 
@@ -163,22 +148,33 @@ inline std::vector<std::int64_t> sort_index(
         throw DataFrameException("Column " + by + " is not valid");
     }
 
-    internal::SortVisitor visitor(rev);
-    DF_ARROW_ERROR_HANDLER(df[by].data()->Accept(&visitor));
+    auto chunks = df[by].chunks();
+    internal::SortVisitor visitor(chunks, rev);
+    DF_ARROW_ERROR_HANDLER(visit_type(df[by].type_id(), visitor));
 
     return std::move(visitor.index);
 }
 
-inline DataFrame sort(
-    const DataFrame &df, const std::string &by, bool rev = false)
+inline DataFrame sort(const DataFrame &df, const std::string &by,
+    bool rev = false,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
 {
+    // Skip sorting a column already known to be in order
+    if (!rev && df[by]) {
+        auto stats = df[by].cached_stats();
+        if (stats != nullptr && stats->sorted && stats->null_count == 0 &&
+            stats->nan_count == 0) {
+            return df;
+        }
+    }
+
     auto index = sort_index(df, by, rev);
 
     if (std::is_sorted(index.begin(), index.end())) {
         return df;
     }
 
-    return select(df, index.begin(), index.end());
+    return select(df, index.begin(), index.end(), pool);
 }
 
 } // namespace dataframe
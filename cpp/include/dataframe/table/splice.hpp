@@ -24,7 +24,7 @@ namespace dataframe {
 namespace internal {
 
 template <typename T>
-class SpliceVisitor : public ::arrow::ArrayVisitor
+class SpliceVisitor
 {
   public:
     SpliceVisitor(T minval, T maxval)
@@ -33,105 +33,76 @@ class SpliceVisitor : public ::arrow::ArrayVisitor
     {
     }
 
-    ::arrow::Status Visit(const ::arrow::Int8Array &array) override
+    template <typename ArrowType>
+    ::arrow::Status operator()(
+        TypeTag<ArrowType> tag, const ::arrow::Array &chunk)
     {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int16Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int32Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Int64Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt8Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt16Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt32Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::UInt64Array &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::FloatArray &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::DoubleArray &array) override
-    {
-        return visit(array);
-    }
-
-    ::arrow::Status Visit(const ::arrow::Date32Array &array) override
-    {
-        return visit(array);
+        using ArrayType = typename decltype(tag)::array_type;
+
+        auto &array = static_cast<const ArrayType &>(chunk);
+
+        if constexpr (std::is_same_v<ArrowType, ::arrow::HalfFloatType>) {
+            return visit(array, static_cast<float>(minval_),
+                static_cast<float>(maxval_),
+                [v = array.raw_values()](auto i) {
+                    return half_to_float(v[i]);
+                });
+        } else if constexpr (is_value_type_v<ArrowType>) {
+            using U = typename ArrowType::c_type;
+            return visit(array, static_cast<U>(minval_),
+                static_cast<U>(maxval_),
+                [v = array.raw_values()](auto i) { return v[i]; });
+        } else {
+            return ::arrow::Status::NotImplemented(
+                "Cannot splice by ", array.type()->ToString());
+        }
     }
 
-    ::arrow::Status Visit(const ::arrow::TimestampArray &array) override
-    {
-        return visit(array);
-    }
+    /// \brief Whether both ends of the range have been found
+    bool done() const { return found_end_; }
 
-    std::size_t begin() const { return begin_; }
-    std::size_t end() const { return end_; }
+    std::size_t begin() const { return static_cast<std::size_t>(begin_); }
+    std::size_t end() const { return static_cast<std::size_t>(end_); }
 
   private:
-    template <typename ArrayType>
-    ::arrow::Status visit(const ArrayType &array)
+    // Called on each chunk in order, the range is carried over between
+    // chunks through offset_
+    template <typename ArrayType, typename U, typename Get>
+    ::arrow::Status visit(
+        const ArrayType &array, U minval, U maxval, Get &&get)
     {
         auto n = array.length();
-        auto v = array.raw_values();
-
-        using U = std::remove_cv_t<std::remove_reference_t<decltype(*v)>>;
-
-        auto minval = static_cast<U>(minval_);
-        auto maxval = static_cast<U>(maxval_);
 
-        std::int64_t begin = 0;
-        if (array.null_count() == 0) {
-            while (begin < n && v[begin] < minval) {
-                ++begin;
-            }
-        } else {
-            while (begin < n && (v[begin] < minval || array.IsNull(begin))) {
-                ++begin;
+        std::int64_t i = 0;
+        if (!found_begin_) {
+            if (array.null_count() == 0) {
+                while (i < n && get(i) < minval) {
+                    ++i;
+                }
+            } else {
+                while (i < n && (get(i) < minval || array.IsNull(i))) {
+                    ++i;
+                }
             }
+            found_begin_ = i < n;
+            begin_ = offset_ + i;
         }
 
-        std::int64_t end = begin;
-        if (array.null_count() == 0) {
-            while (end < n && v[end] < maxval) {
-                ++end;
-            }
-        } else {
-            while (end < n && (v[end] < maxval || array.IsNull(end))) {
-                ++end;
+        if (!found_end_) {
+            if (array.null_count() == 0) {
+                while (i < n && get(i) < maxval) {
+                    ++i;
+                }
+            } else {
+                while (i < n && (get(i) < maxval || array.IsNull(i))) {
+                    ++i;
+                }
             }
+            found_end_ = i < n;
+            end_ = offset_ + i;
         }
 
-        begin_ = static_cast<std::size_t>(begin);
-        end_ = static_cast<std::size_t>(end);
+        offset_ += n;
 
         return ::arrow::Status::OK();
     }
@@ -139,8 +110,11 @@ class SpliceVisitor : public ::arrow::ArrayVisitor
   private:
     T minval_;
     T maxval_;
-    std::size_t begin_;
-    std::size_t end_;
+    bool found_begin_ = false;
+    bool found_end_ = false;
+    std::int64_t offset_ = 0;
+    std::int64_t begin_ = 0;
+    std::int64_t end_ = 0;
 };
 
 } // namespace internal
@@ -154,8 +128,36 @@ inline std::enable_if_t<std::is_arithmetic_v<T>, DataFrame> splice(
         throw DataFrameException(name + " is not an existing column");
     }
 
+    // Known bounds of the column may settle the range without a scan, if
+    // they compare with the arguments the same way as the values do
+    auto id = col.type_id();
+    auto exact = std::is_integral_v<T> ?
+        !col.is_real() && id != ::arrow::Type::HALF_FLOAT :
+        id == ::arrow::Type::DOUBLE;
+    auto stats = exact ? col.cached_stats() : nullptr;
+    if (stats != nullptr && stats->null_count == 0 &&
+        stats->nan_count == 0) {
+        auto min_lo = internal::compare_stats_value(stats->min, minval);
+        auto max_hi = internal::compare_stats_value(stats->max, maxval);
+        if (min_lo && max_hi && *min_lo >= 0 && *max_hi < 0) {
+            return df;
+        }
+
+        auto max_lo = internal::compare_stats_value(stats->max, minval);
+        auto min_hi = internal::compare_stats_value(stats->min, maxval);
+        if ((max_lo && *max_lo < 0) || (min_hi && *min_hi >= 0)) {
+            return DataFrame();
+        }
+    }
+
     internal::SpliceVisitor<T> visitor(minval, maxval);
-    DF_ARROW_ERROR_HANDLER(col.data()->Accept(&visitor));
+    for (auto &&chunk : col.chunks()) {
+        if (visitor.done()) {
+            break;
+        }
+        DF_ARROW_ERROR_HANDLER(visit_type(chunk->type_id(),
+            [&](auto tag) { return visitor(tag, *chunk); }));
+    }
 
     return df.rows(visitor.begin(), visitor.end());
 }
@@ -174,8 +176,8 @@ inline DataFrame splice_datetime(
     } else if (df[name].is_type<Datestamp<DateUnit::Millisecond>>()) {
         data_nanos = time_unit_nanos(DateUnit::Millisecond);
     } else {
-        auto &type = dynamic_cast<const ::arrow::TimestampType &>(
-            *df[name].data()->type());
+        auto &type =
+            dynamic_cast<const ::arrow::TimestampType &>(*df[name].type());
         data_nanos = time_unit_nanos(type.unit());
     }
 
@@ -17,7 +17,12 @@
 #ifndef DATAFRAME_TABLE_SPLIT_HPP
 #define DATAFRAME_TABLE_SPLIT_HPP
 
-#include <dataframe/table/data_frame.hpp>
+#include <dataframe/table/bind.hpp>
+#include <dataframe/table/select.hpp>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
 
 namespace dataframe {
 
@@ -30,41 +35,319 @@ inline std::vector<std::shared_ptr<::arrow::Table>> split_rows(
 
     auto offset = INT64_C(0);
     std::vector<std::shared_ptr<::arrow::Column>> columns;
-    std::vector<std::shared_ptr<::arrow::Field>> fields;
 
     while (offset < table.num_rows()) {
         auto end = std::min(table.num_rows(), offset + nrows);
         auto len = end - offset;
 
+        // Column::Slice handles columns with multiple chunks
         columns.clear();
         for (auto i = 0; i != table.num_columns(); ++i) {
-            auto col = table.column(i);
-            auto chunks = col->data()->chunks();
+            columns.push_back(table.column(i)->Slice(offset, len));
+        }
+
+        ret.push_back(::arrow::Table::Make(table.schema(), columns, len));
+
+        offset = end;
+    }
+
+    return ret;
+}
+
+// Estimated bytes per row of a column that does not depend on the row,
+// variable width string and binary columns are measured row by row instead
+inline double fixed_row_bytes(const ConstColumnProxy &col)
+{
+    auto type = col.type();
+
+    if (type->id() == ::arrow::Type::STRING ||
+        type->id() == ::arrow::Type::BINARY) {
+        return (col.null_count() == 0 ? 0.0 : 0.125) + sizeof(std::int32_t);
+    }
+
+    if (type->id() == ::arrow::Type::DICTIONARY) {
+        type = static_cast<const ::arrow::DictionaryType &>(*type)
+                   .index_type();
+    }
+
+    auto fixed = dynamic_cast<const ::arrow::FixedWidthType *>(type.get());
+    if (fixed != nullptr) {
+        return (col.null_count() == 0 ? 0.0 : 0.125) +
+            static_cast<double>(fixed->bit_width()) / 8;
+    }
+
+    // Nested types are charged the average size of their buffers
+    return col.size() == 0 ? 0.0 :
+                             static_cast<double>(col.memory_usage()) /
+            static_cast<double>(col.size());
+}
+
+// Call `f(row, bytes)` for the value bytes of each row of a string or
+// binary column
+template <typename F>
+inline void variable_row_bytes(const ConstColumnProxy &col, F &&f)
+{
+    auto id = col.type()->id();
+    if (id != ::arrow::Type::STRING && id != ::arrow::Type::BINARY) {
+        return;
+    }
+
+    std::size_t row = 0;
+    for (auto &&chunk : col.chunks()) {
+        auto &array = static_cast<const ::arrow::BinaryArray &>(*chunk);
+        auto offsets = array.raw_value_offsets();
+        auto n = array.length();
+        for (std::int64_t i = 0; i != n; ++i) {
+            f(row++, offsets[i + 1] - offsets[i]);
+        }
+    }
+}
+
+inline double frame_bytes(const DataFrame &df)
+{
+    double ret = 0;
+
+    auto ncol = df.ncol();
+    for (std::size_t j = 0; j != ncol; ++j) {
+        auto col = df[j];
+        ret += fixed_row_bytes(col) * static_cast<double>(col.size());
+
+        auto id = col.type()->id();
+        if (id == ::arrow::Type::STRING || id == ::arrow::Type::BINARY) {
+            for (auto &&chunk : col.chunks()) {
+                auto &array =
+                    static_cast<const ::arrow::BinaryArray &>(*chunk);
+                auto offsets = array.raw_value_offsets();
+                ret += offsets[array.length()] - offsets[0];
+            }
+        }
+    }
 
-            if (chunks.size() != 1) {
-                throw std::runtime_error("Unexpected chunked array");
+    return ret;
+}
+
+class PartitionVisitor
+{
+  public:
+    /// \brief The partition of each row
+    std::vector<std::size_t> ids;
+
+    /// \brief The number of partitions
+    std::size_t nparts = 0;
+
+    /// \brief Assign rows to `n` partitions by the hash of the key, or one
+    /// partition per distinct key in order of appearance if `n` is zero.
+    /// Null keys go to the first partition, or to a partition of their own
+    /// when splitting by distinct keys
+    PartitionVisitor(const ::arrow::ArrayVector &chunks, std::size_t n)
+        : chunks_(chunks)
+        , n_(n)
+    {
+    }
+
+    template <typename ArrowType>
+    ::arrow::Status operator()(TypeTag<ArrowType> tag)
+    {
+        using ArrayType = typename decltype(tag)::array_type;
+
+        if constexpr (std::is_same_v<ArrowType,
+                          ::arrow::FixedSizeBinaryType>) {
+            return visit<ArrayType>([](auto &&array, auto i) {
+                return std::string_view(
+                    reinterpret_cast<const char *>(array.GetValue(i)),
+                    static_cast<std::size_t>(array.byte_width()));
+            });
+        } else if constexpr (std::is_same_v<ArrowType, ::arrow::StringType> ||
+            std::is_same_v<ArrowType, ::arrow::BinaryType>) {
+            return visit<ArrayType>([](auto &&array, auto i) {
+                auto v = array.GetView(i);
+                return std::string_view(v.data(), v.size());
+            });
+        } else if constexpr (is_value_type_v<ArrowType> ||
+            std::is_same_v<ArrowType, ::arrow::BooleanType>) {
+            // Half floats are partitioned by their bits
+            return visit<ArrayType>(
+                [](auto &&array, auto i) { return array.Value(i); });
+        } else if constexpr (std::is_same_v<ArrowType,
+                                 ::arrow::DictionaryType>) {
+            return visit_dictionary();
+        } else {
+            return ::arrow::Status::NotImplemented("Cannot partition by ",
+                chunks_.front()->type()->ToString());
+        }
+    }
+
+  private:
+    ::arrow::Status visit_dictionary()
+    {
+        // Partition the dictionary values once, then map the indices
+        ::arrow::ArrayVector dicts;
+        ::arrow::ArrayVector indices;
+        std::vector<std::int64_t> offsets = {0};
+        for (auto &&chunk : chunks_) {
+            auto &array =
+                static_cast<const ::arrow::DictionaryArray &>(*chunk);
+            dicts.push_back(array.dictionary());
+            indices.push_back(cast_array<std::int64_t>(array.indices()));
+            offsets.push_back(offsets.back() + dicts.back()->length());
+        }
+
+        PartitionVisitor visitor(dicts, n_);
+        ARROW_RETURN_NOT_OK(visit_type(dicts.front()->type_id(), visitor));
+
+        // Renumber distinct values by their first appearance in the rows
+        std::vector<std::size_t> remap(visitor.nparts, visitor.nparts);
+        std::size_t null_id = n_ == 0 ? visitor.nparts : 0;
+
+        nparts = n_;
+        for (std::size_t k = 0; k != indices.size(); ++k) {
+            auto &index =
+                static_cast<const ::arrow::Int64Array &>(*indices[k]);
+            auto n = index.length();
+            auto v = index.raw_values();
+            for (std::int64_t i = 0; i != n; ++i) {
+                if (index.IsNull(i)) {
+                    if (null_id == visitor.nparts) {
+                        null_id = nparts++;
+                    }
+                    ids.push_back(null_id);
+                    continue;
+                }
+
+                auto id = visitor.ids[static_cast<std::size_t>(
+                    offsets[k] + v[i])];
+
+                if (n_ == 0) {
+                    if (remap[id] == visitor.nparts) {
+                        remap[id] = nparts++;
+                    }
+                    id = remap[id];
+                }
+
+                ids.push_back(id);
             }
+        }
 
-            auto values = chunks.front()->Slice(offset, len);
+        return ::arrow::Status::OK();
+    }
+
+    template <typename ArrayType, typename Get>
+    ::arrow::Status visit(Get &&get)
+    {
+        using T = std::decay_t<decltype(
+            get(std::declval<const ArrayType &>(), std::int64_t()))>;
 
-            columns.push_back(std::make_shared<::arrow::Column>(
-                ::arrow::field(col->name(), values->type()), values));
+        std::int64_t length = 0;
+        for (auto &&chunk : chunks_) {
+            length += chunk->length();
         }
+        ids.reserve(static_cast<std::size_t>(length));
 
-        fields.clear();
-        for (auto &&c : columns) {
-            fields.push_back(c->field());
+        if (n_ == 0) {
+            constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+            std::unordered_map<T, std::size_t> memo;
+            auto null_id = npos;
+            for (auto &&chunk : chunks_) {
+                auto &array = static_cast<const ArrayType &>(*chunk);
+                auto n = array.length();
+                for (std::int64_t i = 0; i != n; ++i) {
+                    if (array.IsNull(i)) {
+                        if (null_id == npos) {
+                            null_id = nparts++;
+                        }
+                        ids.push_back(null_id);
+                    } else {
+                        auto iter = memo.emplace(get(array, i), nparts);
+                        nparts += iter.second;
+                        ids.push_back(iter.first->second);
+                    }
+                }
+            }
+        } else {
+            std::hash<T> hash;
+            nparts = n_;
+            for (auto &&chunk : chunks_) {
+                auto &array = static_cast<const ArrayType &>(*chunk);
+                auto n = array.length();
+                for (std::int64_t i = 0; i != n; ++i) {
+                    ids.push_back(array.IsNull(i) ?
+                            0 :
+                            mix(hash(get(array, i))) % n_);
+                }
+            }
         }
 
-        ret.push_back(::arrow::Table::Make(
-            std::make_shared<::arrow::Schema>(fields), columns));
+        return ::arrow::Status::OK();
+    }
+
+    // std::hash is the identity for integers on common implementations
+    static std::size_t mix(std::size_t h)
+    {
+        auto x = static_cast<std::uint64_t>(h);
+        x ^= x >> 33;
+        x *= UINT64_C(0xff51afd7ed558ccd);
+        x ^= x >> 33;
+        x *= UINT64_C(0xc4ceb9fe1a85ec53);
+        x ^= x >> 33;
 
-        offset = end;
+        return static_cast<std::size_t>(x);
+    }
+
+  private:
+    const ::arrow::ArrayVector &chunks_;
+    std::size_t n_;
+};
+
+inline std::vector<DataFrame> scatter_rows(const DataFrame &df,
+    const std::vector<std::size_t> &ids, std::size_t nparts,
+    ::arrow::MemoryPool *pool)
+{
+    // Histogram of partition ids, then a stable counting sort of the rows
+    std::vector<std::int64_t> offsets(nparts + 1);
+    for (auto id : ids) {
+        ++offsets[id + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    std::vector<std::int64_t> index(ids.size());
+    std::vector<std::int64_t> pos(offsets.begin(), offsets.end() - 1);
+    auto n = static_cast<std::int64_t>(ids.size());
+    for (std::int64_t i = 0; i != n; ++i) {
+        auto &p = pos[ids[static_cast<std::size_t>(i)]];
+        index[static_cast<std::size_t>(p++)] = i;
+    }
+
+    // Gather each column once in partition order, the partitions are then
+    // slices sharing the gathered buffers
+    auto grouped = select(df, index.begin(), index.end(), pool);
+
+    std::vector<DataFrame> ret;
+    ret.reserve(nparts);
+    for (std::size_t k = 0; k != nparts; ++k) {
+        // Empty partitions keep the columns
+        ret.emplace_back(grouped.table().Slice(
+            offsets[k], offsets[k + 1] - offsets[k]));
     }
 
     return ret;
 }
 
+inline std::vector<DataFrame> partition_rows(const DataFrame &df,
+    const std::string &key, std::size_t nparts, ::arrow::MemoryPool *pool)
+{
+    auto col = df[key];
+    if (!col) {
+        throw DataFrameException("Column " + key + " is not valid");
+    }
+
+    auto chunks = col.chunks();
+    PartitionVisitor visitor(chunks, nparts);
+    DF_ARROW_ERROR_HANDLER(visit_type(chunks.front()->type_id(), visitor));
+
+    return scatter_rows(df, visitor.ids, visitor.nparts, pool);
+}
+
 } // namespace internal
 
 inline std::vector<DataFrame> split_rows(
@@ -90,6 +373,141 @@ inline std::vector<DataFrame> split_rows(
     return ret;
 }
 
+/// \brief Split a DataFrame into zero-copy slices of roughly `target_bytes`
+/// each
+///
+/// Fixed width columns are charged their width per row and string or binary
+/// columns their offsets and value bytes. Each slice holds at least one row
+inline std::vector<DataFrame> split_bytes(
+    const DataFrame &df, std::size_t target_bytes)
+{
+    if (target_bytes == 0) {
+        throw DataFrameException("Non-positive split byte size");
+    }
+
+    auto nrow = df.nrow();
+    auto ncol = df.ncol();
+
+    if (nrow == 0) {
+        return std::vector{df};
+    }
+
+    double fixed = 0;
+    std::vector<double> bytes;
+    for (std::size_t j = 0; j != ncol; ++j) {
+        auto col = df[j];
+        fixed += internal::fixed_row_bytes(col);
+        internal::variable_row_bytes(col, [&](auto row, auto n) {
+            if (bytes.empty()) {
+                bytes.resize(nrow);
+            }
+            bytes[row] += n;
+        });
+    }
+
+    auto target = static_cast<double>(target_bytes);
+
+    if (bytes.empty()) {
+        if (fixed <= 0) {
+            return std::vector{df};
+        }
+
+        auto nrows = static_cast<std::size_t>(target / fixed);
+
+        return split_rows(df, std::max(nrows, static_cast<std::size_t>(1)));
+    }
+
+    std::vector<DataFrame> ret;
+    std::size_t begin = 0;
+    double sum = 0;
+    for (std::size_t i = 0; i != nrow; ++i) {
+        sum += fixed + bytes[i];
+        if (sum >= target) {
+            ret.push_back(df.rows(begin, i + 1));
+            begin = i + 1;
+            sum = 0;
+        }
+    }
+
+    if (begin != nrow) {
+        ret.push_back(df.rows(begin, nrow));
+    }
+
+    return ret;
+}
+
+/// \brief Merge consecutive DataFrames into DataFrames of roughly
+/// `target_bytes` each, the inverse of `split_bytes`
+///
+/// DataFrames are combined in order with `bind_rows`, one that is already
+/// larger than the target is kept as is
+inline std::vector<DataFrame> coalesce(
+    const std::vector<DataFrame> &dfs, std::size_t target_bytes)
+{
+    if (target_bytes == 0) {
+        throw DataFrameException("Non-positive coalesce byte size");
+    }
+
+    auto target = static_cast<double>(target_bytes);
+
+    std::vector<DataFrame> ret;
+    auto first = dfs.begin();
+    double sum = 0;
+
+    auto flush = [&](auto last) {
+        if (first == last) {
+            return;
+        }
+
+        if (std::distance(first, last) == 1) {
+            ret.push_back(*first);
+        } else {
+            ret.push_back(bind_rows(first, last));
+        }
+
+        first = last;
+        sum = 0;
+    };
+
+    for (auto iter = dfs.begin(); iter != dfs.end(); ++iter) {
+        auto bytes = internal::frame_bytes(*iter);
+        if (sum != 0 && sum + bytes > target) {
+            flush(iter);
+        }
+        sum += bytes;
+        if (sum >= target) {
+            flush(iter + 1);
+        }
+    }
+    flush(dfs.end());
+
+    return ret;
+}
+
+/// \brief Split a DataFrame into one DataFrame per distinct value of a key
+/// column, in order of first appearance. Rows keep their relative order and
+/// rows with a null key form a group of their own
+inline std::vector<DataFrame> split_by(const DataFrame &df,
+    const std::string &key,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    return internal::partition_rows(df, key, 0, pool);
+}
+
+/// \brief Split a DataFrame into `nparts` DataFrames by the hash of a key
+/// column, rows with equal keys always go to the same partition and some
+/// partitions may be empty
+inline std::vector<DataFrame> partition(const DataFrame &df,
+    const std::string &key, std::size_t nparts,
+    ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+{
+    if (nparts == 0) {
+        throw DataFrameException("Non-positive number of partitions");
+    }
+
+    return internal::partition_rows(df, key, nparts, pool);
+}
+
 } // namespace dataframe
 
 #endif // DATAFRAME_TABLE_SPLIT_HPP
@@ -0,0 +1,416 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#ifndef DATAFRAME_TABLE_TYPED_FRAME_HPP
+#define DATAFRAME_TABLE_TYPED_FRAME_HPP
+
+#include <dataframe/table/data_frame.hpp>
+#include <tuple>
+#include <utility>
+
+namespace dataframe {
+
+/// \brief Compile time description of a column of a TypedFrame
+///
+/// The name is given as a pointer to a character array with static storage,
+/// e.g.,
+/// ~~~{.cpp}
+/// inline constexpr char px[] = "px";
+/// using Px = Column<px, double>;
+/// ~~~
+template <const char *Name, typename T>
+struct Column {
+    static_assert(
+        std::is_same_v<typename ArrayView<T>::const_iterator, const T *>,
+        "TypedFrame columns must be of fixed width types with contiguous "
+        "values");
+
+    using value_type = T;
+
+    static constexpr const char *name = Name;
+};
+
+/// \brief A DataFrame bound to a fixed schema
+///
+/// The views of all columns are bound once on construction, columns not
+/// already of the given types are cast with `ConstColumnProxy::as`. Access
+/// through rows is then resolved at compile time to an offset from the
+/// start of the column and involves neither name lookup nor type dispatch.
+/// As with ArrayView, the values of null slots are unspecified, use
+/// `Row::is_null` where the columns may contain nulls
+template <typename... Columns>
+class TypedFrame
+{
+    static_assert(sizeof...(Columns) != 0);
+
+    template <std::size_t I>
+    using ColumnType = std::tuple_element_t<I, std::tuple<Columns...>>;
+
+    template <std::size_t I>
+    using ValueType = typename ColumnType<I>::value_type;
+
+  public:
+    /// \brief Index of the column with the given name
+    template <const char *Name>
+    static constexpr std::size_t index_of()
+    {
+        constexpr bool match[] = {(Columns::name == Name)...};
+
+        for (std::size_t i = 0; i != sizeof...(Columns); ++i) {
+            if (match[i]) {
+                return i;
+            }
+        }
+
+        return sizeof...(Columns);
+    }
+
+    class Row
+    {
+      public:
+        Row(const TypedFrame *frame, std::size_t pos) noexcept
+            : frame_(frame)
+            , pos_(pos)
+        {
+        }
+
+        template <const char *Name>
+        const auto &get() const noexcept
+        {
+            return std::get<checked_index<Name>()>(frame_->ptrs_)[pos_];
+        }
+
+        template <const char *Name>
+        bool is_null() const noexcept
+        {
+            return std::get<checked_index<Name>()>(frame_->views_)
+                .is_null(pos_);
+        }
+
+        std::size_t index() const noexcept { return pos_; }
+
+      private:
+        const TypedFrame *frame_;
+        std::size_t pos_;
+    };
+
+    class iterator
+    {
+      public:
+        using value_type = Row;
+        using reference = Row;
+        using difference_type = std::ptrdiff_t;
+        using pointer = iterator;
+        using iterator_category = std::random_access_iterator_tag;
+
+        iterator() = default;
+
+        iterator(const TypedFrame *ptr, std::size_t pos) noexcept
+            : ptr_(ptr)
+            , pos_(static_cast<std::ptrdiff_t>(pos))
+        {
+        }
+
+        reference operator*() const noexcept
+        {
+            return Row(ptr_, static_cast<std::size_t>(pos_));
+        }
+
+        iterator &operator++() noexcept
+        {
+            ++pos_;
+
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto ret = *this;
+            ++(*this);
+
+            return ret;
+        }
+
+        iterator &operator--() noexcept
+        {
+            --pos_;
+
+            return *this;
+        }
+
+        iterator operator--(int) noexcept
+        {
+            auto ret = *this;
+            --(*this);
+
+            return ret;
+        }
+
+        iterator &operator+=(difference_type n) noexcept
+        {
+            pos_ += n;
+
+            return *this;
+        }
+
+        iterator &operator-=(difference_type n) noexcept
+        {
+            return *this += -n;
+        }
+
+        iterator operator+(difference_type n) const noexcept
+        {
+            auto ret = *this;
+            ret += n;
+
+            return ret;
+        }
+
+        iterator operator-(difference_type n) const noexcept
+        {
+            auto ret = *this;
+            ret -= n;
+
+            return ret;
+        }
+
+        friend iterator operator+(
+            difference_type n, const iterator &iter) noexcept
+        {
+            return iter + n;
+        }
+
+        friend difference_type operator-(
+            const iterator &x, const iterator &y) noexcept
+        {
+            return x.pos_ - y.pos_;
+        }
+
+        reference operator[](difference_type n) const noexcept
+        {
+            return *(*this + n);
+        }
+
+        friend bool operator==(const iterator &x, const iterator &y) noexcept
+        {
+            return x.pos_ == y.pos_ && x.ptr_ == y.ptr_;
+        }
+
+        friend bool operator!=(const iterator &x, const iterator &y) noexcept
+        {
+            return !(x == y);
+        }
+
+        friend bool operator<(const iterator &x, const iterator &y) noexcept
+        {
+            return x.pos_ < y.pos_ && x.ptr_ == y.ptr_;
+        }
+
+        friend bool operator>(const iterator &x, const iterator &y) noexcept
+        {
+            return y < x;
+        }
+
+        friend bool operator<=(const iterator &x, const iterator &y) noexcept
+        {
+            return !(y < x);
+        }
+
+        friend bool operator>=(const iterator &x, const iterator &y) noexcept
+        {
+            return !(x < y);
+        }
+
+      private:
+        const TypedFrame *ptr_ = nullptr;
+        std::ptrdiff_t pos_ = 0;
+    };
+
+    using value_type = Row;
+    using reference = Row;
+
+    TypedFrame(::dataframe::DataFrame data,
+        ::arrow::MemoryPool *pool = ::arrow::default_memory_pool())
+        : data_(std::move(data))
+    {
+        bind(pool, std::index_sequence_for<Columns...>());
+    }
+
+    // The views share the arrays, copying or moving them does not
+    // invalidate the pointers into their values
+    TypedFrame(const TypedFrame &) = default;
+    TypedFrame(TypedFrame &&) noexcept = default;
+
+    TypedFrame &operator=(const TypedFrame &) = default;
+    TypedFrame &operator=(TypedFrame &&) noexcept = default;
+
+    /// \brief Construct from a range of records in a single pass
+    ///
+    /// The `k`-th column is read from the `k`-th member, given either as
+    /// member pointers or, if none is given, by `std::get<k>` for tuple-like
+    /// records
+    template <typename ForwardIter, typename... Members>
+    static TypedFrame from_records(
+        ForwardIter first, ForwardIter last, Members... members)
+    {
+        static_assert(sizeof...(Members) == 0 ||
+            sizeof...(Members) == sizeof...(Columns));
+
+        std::tuple<std::vector<typename Columns::value_type>...> cols;
+        auto n = static_cast<std::size_t>(std::distance(first, last));
+        std::apply([n](auto &... vec) { (vec.reserve(n), ...); }, cols);
+
+        for (; first != last; ++first) {
+            push_record(cols, *first, std::index_sequence_for<Columns...>(),
+                members...);
+        }
+
+        ::dataframe::DataFrame ret;
+        assign_columns(ret, cols, std::index_sequence_for<Columns...>());
+
+        return TypedFrame(std::move(ret));
+    }
+
+    template <typename R, typename... Members>
+    static TypedFrame from_records(
+        const std::vector<R> &records, Members... members)
+    {
+        return from_records(records.begin(), records.end(), members...);
+    }
+
+    /// \brief Convert to records in a single pass
+    ///
+    /// Without member pointers each record is brace initialized with the
+    /// values of all columns in order, otherwise the `k`-th column is
+    /// assigned to the `k`-th member of a value initialized record
+    template <typename R, typename... Members>
+    std::vector<R> to_records(Members... members) const
+    {
+        static_assert(sizeof...(Members) == 0 ||
+            sizeof...(Members) == sizeof...(Columns));
+
+        std::vector<R> ret;
+        ret.reserve(size());
+
+        auto n = size();
+        for (std::size_t i = 0; i != n; ++i) {
+            ret.push_back(make_record<R>(
+                i, std::index_sequence_for<Columns...>(), members...));
+        }
+
+        return ret;
+    }
+
+    std::size_t size() const noexcept { return size_; }
+
+    bool empty() const noexcept { return size_ == 0; }
+
+    const ::dataframe::DataFrame &data() const noexcept { return data_; }
+
+    /// \brief The view of the column with the given name
+    template <const char *Name>
+    const auto &column() const noexcept
+    {
+        return std::get<checked_index<Name>()>(views_);
+    }
+
+    Row front() const noexcept { return Row(this, 0); }
+
+    Row back() const noexcept { return Row(this, size_ - 1); }
+
+    Row operator[](std::size_t i) const noexcept { return Row(this, i); }
+
+    Row at(std::size_t i) const
+    {
+        if (i >= size_) {
+            throw std::out_of_range("TypedFrame::at");
+        }
+
+        return Row(this, i);
+    }
+
+    iterator begin() const noexcept { return iterator(this, 0); }
+
+    iterator end() const noexcept { return iterator(this, size_); }
+
+  private:
+    template <const char *Name>
+    static constexpr std::size_t checked_index()
+    {
+        constexpr auto ret = index_of<Name>();
+        static_assert(ret < sizeof...(Columns), "Column not in TypedFrame");
+
+        return ret;
+    }
+
+    template <std::size_t... I>
+    void bind(::arrow::MemoryPool *pool, std::index_sequence<I...>)
+    {
+        size_ = data_.nrow();
+        const auto &data = data_;
+        ((std::get<I>(views_) =
+                 data[ColumnType<I>::name].template as<ValueType<I>>(pool)),
+            ...);
+        ((std::get<I>(ptrs_) = std::get<I>(views_).begin()), ...);
+    }
+
+    template <typename Cols, typename R, std::size_t... I,
+        typename... Members>
+    static void push_record(Cols &cols, const R &rec,
+        std::index_sequence<I...>, Members... members)
+    {
+        if constexpr (sizeof...(Members) == 0) {
+            using std::get;
+            (std::get<I>(cols).push_back(
+                 static_cast<ValueType<I>>(get<I>(rec))),
+                ...);
+        } else {
+            (std::get<I>(cols).push_back(
+                 static_cast<ValueType<I>>(rec.*members)),
+                ...);
+        }
+    }
+
+    template <typename Cols, std::size_t... I>
+    static void assign_columns(::dataframe::DataFrame &df, Cols &cols,
+        std::index_sequence<I...>)
+    {
+        ((df[ColumnType<I>::name] = std::move(std::get<I>(cols))), ...);
+    }
+
+    template <typename R, std::size_t... I, typename... Members>
+    R make_record(std::size_t i, std::index_sequence<I...>,
+        Members... members) const
+    {
+        if constexpr (sizeof...(Members) == 0) {
+            return R{std::get<I>(ptrs_)[i]...};
+        } else {
+            R ret{};
+            ((ret.*members = std::get<I>(ptrs_)[i]), ...);
+
+            return ret;
+        }
+    }
+
+    ::dataframe::DataFrame data_;
+    std::size_t size_ = 0;
+    std::tuple<ArrayView<typename Columns::value_type>...> views_;
+    std::tuple<const typename Columns::value_type *...> ptrs_;
+};
+
+} // namespace dataframe
+
+#endif // DATAFRAME_TABLE_TYPED_FRAME_HPP
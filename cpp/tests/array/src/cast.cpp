@@ -15,8 +15,10 @@
 // ============================================================================
 
 #include <dataframe/array/cast.hpp>
+#include <dataframe/array/make.hpp>
 
 #include <catch2/catch.hpp>
+#include <cmath>
 
 #define DEFINE_TEST_SECTION(T, U)                                             \
     SECTION(#U)                                                               \
@@ -102,3 +104,178 @@ TEST_CASE("Cast nested", "[cast_array]")
     DEFINE_TEST_SECTION(::dataframe::Struct<::dataframe::List<int>>,
         ::dataframe::Struct<::dataframe::List<double>>)
 }
+
+TEST_CASE("Cast policies", "[cast_array]")
+{
+    std::vector<std::int64_t> values{
+        1, -2, INT64_C(1) << 40, 4, -(INT64_C(1) << 40)};
+    std::vector<bool> valids{true, true, true, false, true};
+    auto array = ::dataframe::make_array<std::int64_t>(values, valids);
+
+    auto unchecked = ::dataframe::cast_array<std::int32_t>(array);
+    CHECK(unchecked->null_count() == 1);
+    CHECK(unchecked->null_bitmap() == array->null_bitmap());
+
+    auto saturated = ::dataframe::cast_array<std::int32_t>(
+        array, ::dataframe::CastPolicy::Saturate);
+    auto &view = static_cast<const ::arrow::Int32Array &>(*saturated);
+    CHECK(view.Value(0) == 1);
+    CHECK(view.Value(1) == -2);
+    CHECK(view.Value(2) == std::numeric_limits<std::int32_t>::max());
+    CHECK(view.Value(4) == std::numeric_limits<std::int32_t>::min());
+    CHECK(view.IsNull(3));
+
+    CHECK_THROWS_AS(::dataframe::cast_array<std::int32_t>(
+                        array, ::dataframe::CastPolicy::Checked),
+        ::dataframe::DataFrameException);
+
+    auto sliced = array->Slice(0, 2);
+    auto checked = ::dataframe::cast_array<std::int32_t>(
+        sliced, ::dataframe::CastPolicy::Checked);
+    CHECK(checked->Equals(::dataframe::make_array<std::int32_t>(
+        std::vector<std::int32_t>{1, -2})));
+
+    // Out of range values in null slots are ignored
+    auto nulls = ::dataframe::make_array<double>(
+        std::vector<double>{1.5, 1e20}, std::vector<bool>{true, false});
+    CHECK(::dataframe::cast_array<std::int32_t>(
+        nulls, ::dataframe::CastPolicy::Checked)
+              ->null_count() == 1);
+
+    // Floating point out of the integer range saturates even if unchecked
+    auto large = ::dataframe::make_array<double>(
+        std::vector<double>{1e20, -1e20, std::nan("")});
+    auto clamped = ::dataframe::cast_array<std::int32_t>(large);
+    CHECK(clamped->Equals(::dataframe::make_array<std::int32_t>(
+        std::vector<std::int32_t>{std::numeric_limits<std::int32_t>::max(),
+            std::numeric_limits<std::int32_t>::min(), 0})));
+}
+
+TEST_CASE("Cast by reinterpretation", "[cast_array]")
+{
+    using Nanos = ::dataframe::Timestamp<::dataframe::TimeUnit::Nanosecond>;
+    using Millis = ::dataframe::Timestamp<::dataframe::TimeUnit::Millisecond>;
+    using Date = ::dataframe::Datestamp<::dataframe::DateUnit::Millisecond>;
+
+    auto ints = ::dataframe::make_array<std::int64_t>(
+        std::vector<std::int64_t>{1, 2, 3});
+    CHECK(::dataframe::cast_kind<Nanos>(*ints) ==
+        ::dataframe::CastKind::Reinterpret);
+    auto nanos = ::dataframe::cast_array<Nanos>(ints);
+    CHECK(::dataframe::is_type<Nanos>(nanos));
+    CHECK(nanos->data()->buffers[1] == ints->data()->buffers[1]);
+
+    auto dates = ::dataframe::cast_array<Date>(ints);
+    auto millis = ::dataframe::cast_array<Millis>(dates);
+    CHECK(millis->data()->buffers[1] == ints->data()->buffers[1]);
+    CHECK(::dataframe::cast_kind<Nanos>(*millis) ==
+        ::dataframe::CastKind::Convert);
+
+    auto small = ::dataframe::make_array<std::uint32_t>(
+        std::vector<std::uint32_t>{1, 2, 0xFFFFFFFFU},
+        std::vector<bool>{true, true, false});
+    auto signs = ::dataframe::cast_array<std::int32_t>(small);
+    CHECK(signs->data()->buffers[1] == small->data()->buffers[1]);
+
+    auto large = ::dataframe::make_array<std::uint32_t>(
+        std::vector<std::uint32_t>{1, 2, 0xFFFFFFFFU});
+    CHECK(::dataframe::cast_kind<std::int32_t>(*large) ==
+        ::dataframe::CastKind::Reinterpret);
+    CHECK(::dataframe::cast_kind<std::int32_t>(
+              *large, ::dataframe::CastPolicy::Checked) ==
+        ::dataframe::CastKind::Convert);
+
+    // A time of day is not a time since the epoch
+    using Time = ::dataframe::Time<::dataframe::TimeUnit::Nanosecond>;
+    auto times = ::dataframe::cast_array<Time>(ints);
+    CHECK(times->data()->buffers[1] == ints->data()->buffers[1]);
+    CHECK(::dataframe::cast_kind<Nanos>(*times) ==
+        ::dataframe::CastKind::Convert);
+
+    auto doubles = ::dataframe::make_array<double>(
+        std::vector<double>{1, 2, 3});
+    CHECK(::dataframe::cast_kind<std::int64_t>(*doubles) ==
+        ::dataframe::CastKind::Convert);
+}
+
+TEST_CASE("Cast from strings", "[cast_array]")
+{
+    using Nanos = ::dataframe::Timestamp<::dataframe::TimeUnit::Nanosecond>;
+    using Seconds = ::dataframe::Timestamp<::dataframe::TimeUnit::Second>;
+    using Date = ::dataframe::Datestamp<::dataframe::DateUnit::Day>;
+    using Clock = ::dataframe::Time<::dataframe::TimeUnit::Millisecond>;
+
+    auto numbers = ::dataframe::make_array<std::string>(
+        std::vector<std::string>{"42", "+7", "-3", "1.5", "x", "1e40"});
+
+    auto ints = ::dataframe::cast_array<std::int32_t>(numbers);
+    CHECK(ints->null_count() == 3);
+    auto &iview = static_cast<const ::arrow::Int32Array &>(*ints);
+    CHECK(iview.Value(0) == 42);
+    CHECK(iview.Value(1) == 7);
+    CHECK(iview.Value(2) == -3);
+    CHECK(iview.IsNull(3));
+
+    auto doubles = ::dataframe::cast_array<double>(numbers);
+    CHECK(doubles->null_count() == 1);
+    auto &dview = static_cast<const ::arrow::DoubleArray &>(*doubles);
+    CHECK(dview.Value(3) == 1.5);
+    CHECK(dview.Value(5) == 1e40);
+
+    CHECK_THROWS_AS(::dataframe::cast_array<std::int32_t>(
+                        numbers, ::dataframe::CastPolicy::Checked),
+        ::dataframe::DataFrameException);
+
+    auto tiny = ::dataframe::cast_array<double>(
+        ::dataframe::make_array<std::string>(
+            std::vector<std::string>{"1e-400", "-1e400"}),
+        ::dataframe::CastPolicy::Saturate);
+    auto &tview = static_cast<const ::arrow::DoubleArray &>(*tiny);
+    CHECK(tview.Value(0) == 0);
+    CHECK(tview.Value(1) == std::numeric_limits<double>::lowest());
+
+    auto times = ::dataframe::make_array<std::string>(
+        std::vector<std::string>{"1970-01-01", "2019-07-01T09:30:00.5+08:00",
+            "1969-12-31 23:59:59.25Z", "2019-02-29"});
+
+    auto nanos = ::dataframe::cast_array<Nanos>(times);
+    auto &nview = static_cast<const ::arrow::TimestampArray &>(*nanos);
+    CHECK(nview.Value(0) == 0);
+    CHECK(nview.Value(1) == INT64_C(1561944600500000000));
+    CHECK(nview.Value(2) == -750'000'000);
+    CHECK(nview.IsNull(3));
+
+    auto seconds = ::dataframe::cast_array<Seconds>(times);
+    CHECK(static_cast<const ::arrow::TimestampArray &>(*seconds).Value(2) ==
+        -1);
+
+    auto dates = ::dataframe::cast_array<Date>(times);
+    CHECK(static_cast<const ::arrow::Date32Array &>(*dates).Value(1) ==
+        18078);
+
+    // Dates in milliseconds are whole days as well
+    using DateMillis =
+        ::dataframe::Datestamp<::dataframe::DateUnit::Millisecond>;
+    auto millis = ::dataframe::cast_array<DateMillis>(times);
+    auto &mview = static_cast<const ::arrow::Date64Array &>(*millis);
+    CHECK(mview.Value(1) == INT64_C(18078) * 86'400'000);
+    CHECK(mview.Value(2) == -86'400'000);
+
+    auto clocks = ::dataframe::cast_array<Clock>(
+        ::dataframe::make_array<std::string>(
+            std::vector<std::string>{"09:30:00.125", "25:00"}));
+    CHECK(static_cast<const ::arrow::Time32Array &>(*clocks).Value(0) ==
+        34200125);
+    CHECK(clocks->IsNull(1));
+
+    std::vector<std::string> many(
+        static_cast<std::size_t>(::dataframe::internal::parse_block_size * 3),
+        std::string("12"));
+    many[5] = "bad";
+    auto parallel = ::dataframe::cast_array<std::int64_t>(
+        ::dataframe::make_array<std::string>(many));
+    CHECK(parallel->null_count() == 1);
+    CHECK(parallel->IsNull(5));
+    CHECK(static_cast<const ::arrow::Int64Array &>(*parallel).Value(
+              parallel->length() - 1) == 12);
+}
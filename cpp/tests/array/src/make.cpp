@@ -20,6 +20,10 @@
 #include "make_data.hpp"
 
 #include <catch2/catch.hpp>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <sstream>
 
 TEMPLATE_TEST_CASE("Make Primitive array", "[make_array][template]", void,
     bool, std::uint8_t, std::int8_t, std::uint16_t, std::int16_t,
@@ -62,6 +66,30 @@ TEMPLATE_TEST_CASE("Make Primitive array", "[make_array][template]", void,
             values.begin(), values.end(), view.begin(), view.end()));
     }
 
+    SECTION("Make array from rvalue")
+    {
+        constexpr bool zero_copy =
+            ::dataframe::internal::IsZeroCopyType<TestType>::value;
+
+        auto copy = values;
+        const void *ptr = nullptr;
+        if constexpr (zero_copy) {
+            ptr = copy.data();
+        }
+
+        auto data = ::dataframe::make_array<TestType>(std::move(copy));
+        auto view = ::dataframe::make_view<TestType>(data);
+
+        CHECK(::dataframe::is_type<TestType>(data->type()));
+        CHECK(data->length() == static_cast<std::int64_t>(n));
+        CHECK(std::equal(
+            values.begin(), values.end(), view.begin(), view.end()));
+
+        if constexpr (zero_copy) {
+            CHECK(data->data()->buffers.at(1)->data() == ptr);
+        }
+    }
+
     SECTION("Make nullable array")
     {
         auto valids = make_data<bool>(n);
@@ -87,3 +115,103 @@ TEMPLATE_TEST_CASE("Make Primitive array", "[make_array][template]", void,
         CHECK(pass);
     }
 }
+
+TEST_CASE("Make array with packed masks", "[make_array]")
+{
+    std::size_t n = 1003;
+
+    auto values = make_data<double>(n);
+    auto valids = make_data<bool>(n);
+
+    std::vector<std::uint8_t> bytes(valids.begin(), valids.end());
+    std::unique_ptr<bool[]> flags(new bool[n]);
+    std::copy(valids.begin(), valids.end(), flags.get());
+
+    auto expected = static_cast<std::int64_t>(n) -
+        std::accumulate(valids.begin(), valids.end(), INT64_C(0));
+
+    auto check = [&](auto &&data) {
+        CHECK(data->null_count() == expected);
+        for (std::size_t i = 0; i != n; ++i) {
+            auto k = static_cast<std::int64_t>(i);
+            if (data->IsValid(k) != valids[i]) {
+                FAIL("Mismatch at " << i);
+            }
+        }
+    };
+
+    check(::dataframe::make_array<double>(values, valids));
+    check(::dataframe::make_array<double>(
+        values.begin(), values.end(), bytes.begin()));
+    check(::dataframe::make_array<double>(
+        values.begin(), values.end(), flags.get()));
+
+    auto all = ::dataframe::make_array<double>(
+        values, std::vector<bool>(n, true));
+    CHECK(all->null_count() == 0);
+    CHECK(all->null_bitmap() == nullptr);
+}
+
+TEST_CASE("Make string array", "[make_array]")
+{
+    std::vector<std::string> values{"a", "bc", "", "def"};
+
+    // Forward input sizes the value buffer once, up to Arrow's padding
+    ::arrow::StringBuilder builder;
+    ::dataframe::ArrayMaker<std::string>::append(
+        &builder, values.begin(), values.end());
+    CHECK(builder.length() == 4);
+    CHECK(builder.value_data_length() == 6);
+    CHECK(builder.value_data_capacity() ==
+        ::arrow::BitUtil::RoundUpToMultipleOf64(6));
+
+    // Single pass input is read once
+    std::istringstream input("a bc def");
+    auto array = ::dataframe::make_array<std::string>(
+        std::istream_iterator<std::string>(input),
+        std::istream_iterator<std::string>());
+    CHECK(array->Equals(::dataframe::make_array<std::string>(
+        std::vector<std::string>{"a", "bc", "def"})));
+}
+
+TEST_CASE("Dictionary encoder", "[make_array]")
+{
+    using D = ::dataframe::Dict<std::string, std::int16_t>;
+
+    auto initial = ::dataframe::make_array<std::string>(
+        std::vector<std::string>{"b", "a"});
+
+    ::dataframe::DictionaryEncoder<std::string, std::int16_t> encoder(
+        initial);
+
+    std::vector<std::string> batch1{"a", "c", "a", "b"};
+    std::vector<std::string> batch2{"d", "c"};
+
+    auto data1 = encoder.encode(batch1.begin(), batch1.end());
+    auto data2 = encoder.encode(batch2.begin(), batch2.end());
+
+    CHECK(::dataframe::is_type<D>(data1->type()));
+    CHECK(encoder.size() == 4);
+
+    auto view1 = ::dataframe::make_view<D>(data1);
+    auto view2 = ::dataframe::make_view<D>(data2);
+    CHECK(std::equal(view1.begin(), view1.end(), batch1.begin()));
+    CHECK(std::equal(view2.begin(), view2.end(), batch2.begin()));
+
+    auto &dict1 = static_cast<const ::arrow::DictionaryArray &>(*data1);
+    auto &dict2 = static_cast<const ::arrow::DictionaryArray &>(*data2);
+    CHECK(dict1.dictionary()->Equals(dict2.dictionary()->Slice(0, 3)));
+    CHECK(dict1.indices()->Equals(::dataframe::make_array<std::int16_t>(
+        std::vector<std::int16_t>{1, 2, 1, 0})));
+    CHECK(dict2.dictionary()->Equals(::dataframe::make_array<std::string>(
+        std::vector<std::string>{"b", "a", "c", "d"})));
+
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> values{nan, 1, -nan, nan};
+    ::dataframe::DictionaryEncoder<double> numbers;
+    auto data3 = numbers.encode(values.begin(), values.end());
+    auto &dict3 = static_cast<const ::arrow::DictionaryArray &>(*data3);
+    CHECK(numbers.size() == 2);
+    CHECK(dict3.indices()->Equals(::dataframe::make_array<std::int32_t>(
+        std::vector<std::int32_t>{0, 1, 0, 0})));
+}
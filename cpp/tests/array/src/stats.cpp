@@ -0,0 +1,105 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/array.hpp>
+
+#include <catch2/catch.hpp>
+#include <limits>
+
+TEST_CASE("Column statistics", "[array]")
+{
+    SECTION("Integer")
+    {
+        std::vector<std::int32_t> values;
+        for (std::int32_t i = 0; i != 10000; ++i) {
+            values.push_back(i % 1000 - 500);
+        }
+
+        auto stats = ::dataframe::compute_stats(
+            ::dataframe::make_array<std::int32_t>(values));
+
+        CHECK(stats.length == 10000);
+        CHECK(stats.null_count == 0);
+        using V = ::dataframe::ColumnStats::value_type;
+        CHECK(stats.min == V(INT64_C(-500)));
+        CHECK(stats.max == V(INT64_C(499)));
+
+        CHECK(::dataframe::internal::compare_stats_value(stats.min, -500) ==
+            0);
+        CHECK(::dataframe::internal::compare_stats_value(stats.max, 500U) ==
+            -1);
+        CHECK(::dataframe::internal::compare_stats_value(
+                  stats.min, std::numeric_limits<std::uint64_t>::max()) == -1);
+        CHECK(!::dataframe::internal::compare_stats_value(
+            V(std::string("a")), 0));
+        CHECK(!stats.sorted);
+        CHECK(stats.ndv > 950);
+        CHECK(stats.ndv < 1050);
+    }
+
+    SECTION("Sorted chunks")
+    {
+        auto array = ::dataframe::make_array<double>(
+            std::vector<double>{1, 2, 2, 3, 5, 8});
+
+        auto stats = ::dataframe::compute_stats(
+            ::arrow::ArrayVector{array->Slice(0, 3), array->Slice(3)});
+
+        CHECK(stats.sorted);
+        CHECK(stats.min == ::dataframe::ColumnStats::value_type(1.0));
+        CHECK(stats.max == ::dataframe::ColumnStats::value_type(8.0));
+        CHECK(stats.ndv >= 4);
+        CHECK(stats.ndv <= 5);
+
+        stats = ::dataframe::compute_stats(
+            ::arrow::ArrayVector{array->Slice(3), array->Slice(0, 3)});
+        CHECK(!stats.sorted);
+    }
+
+    SECTION("NaN")
+    {
+        auto nan = std::numeric_limits<double>::quiet_NaN();
+        auto stats = ::dataframe::compute_stats(
+            ::dataframe::make_array<double>(std::vector<double>{nan, 1, 0}));
+
+        CHECK(stats.nan_count == 1);
+        CHECK(!stats.sorted);
+        CHECK(stats.min == ::dataframe::ColumnStats::value_type(0.0));
+        CHECK(stats.max == ::dataframe::ColumnStats::value_type(1.0));
+
+        stats = ::dataframe::compute_stats(
+            ::dataframe::make_array<double>(std::vector<double>{0, nan, 1}));
+        CHECK(stats.nan_count == 1);
+        CHECK(stats.sorted);
+    }
+
+    SECTION("String with nulls")
+    {
+        std::vector<std::string> values = {"b", "a", "c", "d"};
+        auto array = ::dataframe::internal::set_mask(
+            ::dataframe::make_array<std::string>(values),
+            std::vector<bool>{true, false, true, true}.begin());
+
+        auto stats = ::dataframe::compute_stats(array);
+
+        CHECK(stats.null_count == 1);
+        CHECK(stats.sorted);
+        CHECK(stats.min ==
+            ::dataframe::ColumnStats::value_type(std::string("b")));
+        CHECK(stats.max ==
+            ::dataframe::ColumnStats::value_type(std::string("d")));
+    }
+}
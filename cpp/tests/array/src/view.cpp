@@ -14,6 +14,8 @@
 // limitations under the License.
 // ============================================================================
 
+#include <dataframe/array/logical.hpp>
+#include <dataframe/array/make.hpp>
 #include <dataframe/array/view.hpp>
 
 #include <catch2/catch.hpp>
@@ -365,7 +367,8 @@ struct TestData<::dataframe::Dict<std::string>> : TestDataBase<std::string> {
 TEMPLATE_TEST_CASE("Make view of array/slice", "[make_view][template]",
     std::uint8_t, std::int8_t, std::uint16_t, std::int16_t, std::uint32_t,
     std::int32_t, std::uint64_t, std::int64_t, float, double, std::string,
-    ::dataframe::Bytes, ::dataframe::Opaque<int>, ::dataframe::Dict<std::string>,
+    ::dataframe::Bytes, ::dataframe::Opaque<int>,
+    ::dataframe::Dict<std::string>,
     ::dataframe::Datestamp<::dataframe::DateUnit::Day>,
     ::dataframe::Datestamp<::dataframe::DateUnit::Millisecond>,
     ::dataframe::Timestamp<::dataframe::TimeUnit::Second>,
@@ -413,3 +416,122 @@ TEMPLATE_TEST_CASE("Make view of array/slice", "[make_view][template]",
         data.check(view, m);
     }
 }
+
+TEST_CASE("Boolean view bulk operations", "[make_view][bool]")
+{
+    std::size_t n = 200;
+    std::vector<bool> v1(n);
+    std::vector<bool> v2(n);
+    std::vector<bool> valid(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        v1[i] = i % 3 == 0;
+        v2[i] = i % 5 == 0;
+        valid[i] = i % 7 != 0;
+    }
+
+    auto a1 = ::dataframe::make_array<bool>(v1);
+    auto a2 = ::dataframe::make_array<bool>(v2, valid);
+
+    for (std::int64_t offset : {0, 8, 3}) {
+        auto s1 = a1->Slice(offset);
+        auto s2 = a2->Slice(offset);
+        auto m = n - static_cast<std::size_t>(offset);
+
+        ::dataframe::ArrayView<bool> x(s1);
+        ::dataframe::ArrayView<bool> y(s2);
+
+        std::size_t count = 0;
+        for (std::size_t i = 0; i != m; ++i) {
+            auto j = i + static_cast<std::size_t>(offset);
+            CHECK(x[i] == v1[j]);
+            count += v2[j] && valid[j];
+        }
+        CHECK(y.count() == count);
+        CHECK(y.any());
+        CHECK(!y.all());
+
+        std::size_t next = 1;
+        while (next != m && !v1[next + static_cast<std::size_t>(offset)]) {
+            ++next;
+        }
+        CHECK(x.find_next_set(1) == next);
+        CHECK(x.find_next_set(m) == m);
+
+        auto z = x & y;
+        auto w = x | y;
+        auto u = x ^ y;
+        auto v = ~x;
+        for (std::size_t i = 0; i != m; ++i) {
+            auto j = i + static_cast<std::size_t>(offset);
+            CHECK(z.data()->IsValid(static_cast<std::int64_t>(i)) == valid[j]);
+            if (valid[j]) {
+                CHECK(z[i] == (v1[j] && v2[j]));
+                CHECK(w[i] == (v1[j] || v2[j]));
+                CHECK(u[i] == (v1[j] != v2[j]));
+            }
+            CHECK(v[i] == !v1[j]);
+        }
+        CHECK(v.data()->null_count() == 0);
+    }
+}
+
+TEST_CASE("Null-aware view blocks", "[make_view][null]")
+{
+    std::size_t n = 300;
+    std::vector<double> values(n);
+    std::vector<bool> valid(n);
+    for (std::size_t i = 0; i != n; ++i) {
+        values[i] = static_cast<double>(i);
+        valid[i] = i < 64 || (i >= 128 && i % 5 != 0);
+    }
+
+    auto array = ::dataframe::make_array<double>(values, valid);
+
+    for (std::int64_t offset : {0, 64, 3}) {
+        auto slice = array->Slice(offset);
+        auto m = n - static_cast<std::size_t>(offset);
+
+        ::dataframe::ArrayView<double> view(slice);
+        CHECK(view.null_count() ==
+            static_cast<std::size_t>(slice->null_count()));
+        CHECK(view.nblocks() == (m + 63) / 64);
+
+        double sum = 0;
+        double expected = 0;
+        for (std::size_t i = 0; i != m; ++i) {
+            auto j = i + static_cast<std::size_t>(offset);
+            CHECK(view.is_valid(i) == valid[j]);
+            CHECK(view.get(i).has_value() == valid[j]);
+            if (valid[j]) {
+                CHECK(*view.get(i) == values[j]);
+                expected += values[j];
+            }
+        }
+
+        view.for_each_block([&](auto &&blk) {
+            for (std::size_t i = 0; i != blk.size; ++i) {
+                sum += blk.is_valid(i) ? blk.values[i] : 0;
+            }
+        });
+        CHECK(sum == expected);
+
+        sum = 0;
+        std::size_t count = 0;
+        view.for_each_span([&](auto first, auto last) {
+            CHECK(first != last);
+            count += static_cast<std::size_t>(last - first);
+            for (auto iter = first; iter != last; ++iter) {
+                sum += *iter;
+            }
+        });
+        CHECK(sum == expected);
+        CHECK(count == m - view.null_count());
+    }
+
+    ::dataframe::ArrayView<double> all(
+        ::dataframe::make_array<double>(values));
+    std::size_t nspans = 0;
+    all.for_each_span([&](auto, auto) { ++nspans; });
+    CHECK(nspans == 1);
+    CHECK(all.block(all.nblocks() - 1).all_valid());
+}
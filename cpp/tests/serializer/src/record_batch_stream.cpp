@@ -44,3 +44,42 @@ TEMPLATE_TEST_CASE("RecordBatchStream", "[serializer][template]", TEST_TYPES)
     TestSerializer<TestType, ::dataframe::RecordBatchStreamReader,
         ::dataframe::RecordBatchStreamWriter>(output.data);
 }
+
+TEST_CASE("RecordBatchStream statistics", "[serializer]")
+{
+    ::dataframe::DataFrame df;
+    df["x"] = std::vector<std::int64_t>{1, 2, 3, 5};
+    df["y"] = std::vector<std::string>{"b", "a", "c", "d"};
+
+    ::dataframe::RecordBatchStreamWriter writer(
+        ::arrow::default_memory_pool(), true);
+    writer.write(df);
+
+    ::dataframe::RecordBatchStreamReader reader;
+    auto ret = reader.read(writer.size(), writer.data());
+
+    CHECK(ret == df);
+
+    auto stats = ret["x"].cached_stats();
+    REQUIRE(stats != nullptr);
+    CHECK(*stats == *df["x"].stats());
+    CHECK(*ret["y"].cached_stats() == *df["y"].stats());
+    CHECK(ret.table().schema()->metadata() == nullptr ||
+        ret.table().schema()->metadata()->size() == 0);
+
+    // Statistics left in the metadata of a rewritten column must not
+    // survive another round trip
+    ::dataframe::DataFrame stale(::dataframe::internal::table_with_stats(df));
+    stale["x"] = std::vector<std::int64_t>{4, 3, 2, 1};
+
+    for (bool write_stats : {false, true}) {
+        ::dataframe::RecordBatchStreamWriter rewriter(
+            ::arrow::default_memory_pool(), write_stats);
+        rewriter.write(stale);
+
+        auto back = reader.read(rewriter.size(), rewriter.data());
+        auto sorted = ::dataframe::sort(back, "x");
+        CHECK(sorted["x"].view<std::int64_t>().front() == 1);
+        CHECK(sorted["x"].view<std::int64_t>().back() == 4);
+    }
+}
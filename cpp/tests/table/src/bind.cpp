@@ -0,0 +1,153 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/table/bind.hpp>
+#include <dataframe/table/split.hpp>
+
+#include <catch2/catch.hpp>
+
+inline ::dataframe::DataFrame make_bind_dataframe(std::size_t n)
+{
+    using Timestamp =
+        ::dataframe::Timestamp<::dataframe::TimeUnit::Nanosecond>;
+
+    std::vector<std::int32_t> int32;
+    std::vector<double> real;
+    std::vector<Timestamp> timestamp;
+    std::vector<std::string> string;
+    std::vector<bool> mask;
+
+    for (std::size_t i = 0; i != n; ++i) {
+        int32.push_back(static_cast<std::int32_t>(i));
+        real.push_back(static_cast<double>(i) / 2);
+        timestamp.push_back(Timestamp(static_cast<std::int64_t>(i)));
+        string.push_back(std::to_string(i));
+        mask.push_back(i % 3 != 0);
+    }
+
+    ::dataframe::DataFrame ret;
+    ret["Int32"] = int32;
+    ret["Double"].emplace<double>(real, mask);
+    ret["Timestamp"] = timestamp;
+    ret["String"].emplace<std::string>(string, mask);
+
+    return ret;
+}
+
+TEST_CASE("Bind rows", "[table]")
+{
+    auto df = make_bind_dataframe(1000);
+    auto chunks = ::dataframe::split_rows(df, 77);
+
+    CHECK(chunks.size() == 13);
+
+    auto ret = ::dataframe::bind_rows(chunks);
+
+    CHECK(ret == df);
+    CHECK(::arrow::ValidateArray(*ret["String"].data()).ok());
+}
+
+TEST_CASE("Bind rows with missing columns", "[table]")
+{
+    auto df1 = make_bind_dataframe(10);
+    auto df2 = make_bind_dataframe(10);
+    df2["String"].remove();
+
+    auto ret = ::dataframe::bind_rows({df1, df2});
+
+    CHECK(ret.nrow() == 20);
+    CHECK(ret.ncol() == 4);
+    CHECK(ret["String"].data()->null_count() ==
+        df1["String"].data()->null_count() + 10);
+    CHECK(ret["String"](10, 20).data()->null_count() == 10);
+}
+
+TEST_CASE("Bind rows with numeric promotion", "[table]")
+{
+    ::dataframe::DataFrame df1;
+    df1["x"] = std::vector<std::int32_t>{1, 2};
+
+    ::dataframe::DataFrame df2;
+    df2["x"] = std::vector<std::int64_t>{3, 4};
+
+    ::dataframe::DataFrame df3;
+    df3["x"] = std::vector<std::uint32_t>{5, 6};
+
+    auto ret = ::dataframe::bind_rows({df1, df2});
+    CHECK(ret["x"].is_type<std::int64_t>());
+    CHECK(ret["x"].view<std::int64_t>().back() == 4);
+
+    ret = ::dataframe::bind_rows({df1, df3});
+    CHECK(ret["x"].is_type<std::int64_t>());
+    CHECK(ret["x"].view<std::int64_t>().back() == 6);
+
+    ::dataframe::DataFrame df4;
+    df4["x"] = std::vector<std::string>{"7", "8"};
+
+    CHECK_THROWS_AS(::dataframe::bind_rows({df1, df4}),
+        ::dataframe::DataFrameException);
+
+    ::dataframe::DataFrame df5;
+    df5["x"] = std::vector<std::uint64_t>{9, 10};
+
+    CHECK_THROWS_WITH(::dataframe::bind_rows({df2, df5}),
+        Catch::Contains("'x'") && Catch::Contains("int64") &&
+            Catch::Contains("uint64"));
+}
+
+TEST_CASE("Bind rows with different dictionaries", "[table]")
+{
+    using T = ::dataframe::Dict<std::string>;
+
+    ::dataframe::DataFrame df1;
+    df1["x"].emplace<T>(std::vector<std::string>{"a", "b", "a"});
+
+    ::dataframe::DataFrame df2;
+    df2["x"].emplace<T>(std::vector<std::string>{"c", "a"});
+
+    auto ret = ::dataframe::bind_rows({df1, df2});
+
+    auto view = ret["x"].view<T>();
+    CHECK(view.dictionary().size() == 3);
+
+    std::vector<std::string> values(view.begin(), view.end());
+    CHECK(values == std::vector<std::string>{"a", "b", "a", "c", "a"});
+
+    // A chunked input whose chunks carry different dictionaries
+    auto schema = df1.table().schema();
+    ::dataframe::DataFrame chunked(::arrow::Table::Make(schema,
+        std::vector<std::shared_ptr<::arrow::Column>>{
+            std::make_shared<::arrow::Column>(schema->field(0),
+                std::make_shared<::arrow::ChunkedArray>(::arrow::ArrayVector{
+                    df1["x"].data(), df2["x"].data()}))}));
+    CHECK(chunked["x"].nchunks() == 2);
+
+    ::dataframe::DataFrame df3;
+    df3["x"].emplace<T>(std::vector<std::string>{"d", "b"});
+
+    for (auto &&df : {::dataframe::bind_rows({chunked, df3}),
+             ::dataframe::bind_rows({ret, df3})}) {
+        CHECK(!df.is_chunked());
+
+        auto chunked_view = df["x"].view<T>();
+        CHECK(chunked_view.dictionary().size() == 4);
+
+        std::vector<std::string> chunked_values(
+            chunked_view.begin(), chunked_view.end());
+        CHECK(chunked_values ==
+            std::vector<std::string>{"a", "b", "a", "c", "a", "d", "b"});
+    }
+}
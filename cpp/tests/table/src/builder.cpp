@@ -0,0 +1,150 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/table/builder.hpp>
+
+#include <catch2/catch.hpp>
+#include <chrono>
+
+using BuilderTimestamp =
+    ::dataframe::Timestamp<::dataframe::TimeUnit::Nanosecond>;
+
+// Counts the allocations made through the default pool
+class CountingMemoryPool : public ::arrow::MemoryPool
+{
+  public:
+    ::arrow::Status Allocate(std::int64_t size, std::uint8_t **out) override
+    {
+        ++count;
+
+        return pool_->Allocate(size, out);
+    }
+
+    ::arrow::Status Reallocate(std::int64_t old_size, std::int64_t new_size,
+        std::uint8_t **ptr) override
+    {
+        ++count;
+
+        return pool_->Reallocate(old_size, new_size, ptr);
+    }
+
+    void Free(std::uint8_t *buffer, std::int64_t size) override
+    {
+        pool_->Free(buffer, size);
+    }
+
+    std::int64_t bytes_allocated() const override
+    {
+        return pool_->bytes_allocated();
+    }
+
+    std::int64_t max_memory() const override { return pool_->max_memory(); }
+
+    std::int64_t count = 0;
+
+  private:
+    ::arrow::MemoryPool *pool_ = ::arrow::default_memory_pool();
+};
+
+TEST_CASE("DataFrameBuilder", "[table]")
+{
+    ::dataframe::DataFrameBuilder<std::int32_t, double, std::string,
+        BuilderTimestamp>
+        builder({"ID", "Price", "Symbol", "Time"});
+
+    for (int k = 0; k != 3; ++k) {
+        for (std::int32_t i = 0; i != 10; ++i) {
+            builder.append(i, static_cast<double>(i) * 0.5,
+                "X" + std::to_string(i), BuilderTimestamp(i * 1000));
+        }
+        CHECK(builder.size() == 10);
+
+        auto df = builder.finish();
+        CHECK(builder.empty());
+
+        CHECK(df.nrow() == 10);
+        CHECK(df.ncol() == 4);
+        CHECK(df["ID"].view<std::int32_t>().back() == 9);
+        CHECK(df["Price"].view<double>().back() == 4.5);
+        CHECK(df["Symbol"].view<std::string>().back() == "X9");
+        CHECK(df["Time"].is_type<BuilderTimestamp>());
+        CHECK(df.table().schema() == builder.schema());
+    }
+}
+
+TEST_CASE("DataFrameBuilder benchmark", "[.benchmark]")
+{
+    constexpr int nframes = 10000;
+    constexpr std::int32_t nrows = 10;
+
+    CountingMemoryPool pool;
+
+    // Microseconds and allocations per frame
+    auto time = [&](auto &&f) {
+        pool.count = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k != nframes; ++k) {
+            f();
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        return std::make_pair(
+            std::chrono::duration<double, std::micro>(stop - start)
+                    .count() /
+                nframes,
+            static_cast<double>(pool.count) / nframes);
+    };
+
+    std::vector<std::int32_t> ids;
+    std::vector<double> prices;
+    std::vector<std::string> symbols;
+    for (std::int32_t i = 0; i != nrows; ++i) {
+        ids.push_back(i);
+        prices.push_back(static_cast<double>(i) * 0.5);
+        symbols.push_back("X" + std::to_string(i));
+    }
+
+    ::arrow::MemoryPool *mp = &pool;
+
+    auto proxy = time([&] {
+        ::dataframe::DataFrame df;
+        df["ID"] = ::dataframe::make_array<std::int32_t>(
+            ids.begin(), ids.end(), mp);
+        df["Price"] =
+            ::dataframe::make_array<double>(prices.begin(), prices.end(), mp);
+        df["Symbol"] = ::dataframe::make_array<std::string>(
+            symbols.begin(), symbols.end(), mp);
+        return df;
+    });
+
+    ::dataframe::DataFrameBuilder<std::int32_t, double, std::string> builder(
+        {"ID", "Price", "Symbol"}, mp);
+    builder.reserve(nrows);
+
+    auto reuse = time([&] {
+        for (std::int32_t i = 0; i != nrows; ++i) {
+            builder.append(ids[static_cast<std::size_t>(i)],
+                prices[static_cast<std::size_t>(i)],
+                symbols[static_cast<std::size_t>(i)]);
+        }
+        return builder.finish();
+    });
+
+    WARN("ColumnProxy: " << proxy.first << "us, " << proxy.second
+                         << " allocations per frame");
+    WARN("DataFrameBuilder: " << reuse.first << "us, " << reuse.second
+                              << " allocations per frame");
+}
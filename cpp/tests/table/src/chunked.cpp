@@ -0,0 +1,168 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/table/bind.hpp>
+#include <dataframe/table/memory.hpp>
+#include <dataframe/table/runs.hpp>
+#include <dataframe/table/sort.hpp>
+#include <dataframe/table/splice.hpp>
+#include <dataframe/table/split.hpp>
+
+#include <catch2/catch.hpp>
+
+inline std::shared_ptr<::arrow::ChunkedArray> make_chunked(
+    const std::vector<std::shared_ptr<::arrow::Array>> &chunks)
+{
+    return std::make_shared<::arrow::ChunkedArray>(chunks);
+}
+
+TEST_CASE("Chunked DataFrame", "[table]")
+{
+    ::dataframe::DataFrame df;
+    df["x"] = std::vector<std::int32_t>{5, 3, 1, 4, 2, 0};
+    df["y"] =
+        std::vector<std::string>{"e", "d", "b", "c", "a", "f"};
+
+    auto x = df["x"].data();
+    auto y = df["y"].data();
+
+    auto schema = df.table().schema();
+    auto table = ::arrow::Table::Make(schema,
+        std::vector<std::shared_ptr<::arrow::Column>>{
+            std::make_shared<::arrow::Column>(schema->field(0),
+                make_chunked({x->Slice(0, 2), x->Slice(2, 0), x->Slice(2)})),
+            std::make_shared<::arrow::Column>(schema->field(1),
+                make_chunked({y->Slice(0, 4), y->Slice(4)}))});
+
+    ::dataframe::DataFrame chunked(std::move(table));
+
+    CHECK(chunked.is_chunked());
+    CHECK(chunked["x"].nchunks() == 3);
+    CHECK(chunked["y"].nchunks() == 2);
+    CHECK(chunked == df);
+    CHECK(!chunked.combine_chunks().is_chunked());
+
+    SECTION("View")
+    {
+        auto view = chunked["x"].chunked_view<std::int32_t>();
+        CHECK(view.size() == 6);
+        CHECK(view[3] == 4);
+        CHECK(std::vector<std::int32_t>(view.begin(), view.end()) ==
+            std::vector<std::int32_t>{5, 3, 1, 4, 2, 0});
+    }
+
+    SECTION("Contiguous view")
+    {
+        const auto &cref = chunked;
+        auto data = cref["x"].data();
+        CHECK(cref["x"].data() == data);
+        CHECK(chunked["x"].data() == data);
+        CHECK(cref[std::size_t(0)].data() == data);
+        CHECK(cref["x"].view<std::int32_t>() == df["x"].view<std::int32_t>());
+
+        auto copy = cref;
+        CHECK(copy["x"].data() == data);
+
+        copy["z"] = ::dataframe::repeat(1);
+        CHECK(copy["x"].data() == data);
+
+        copy["x"] = chunked["y"];
+        CHECK(copy["x"].data() != data);
+        CHECK(copy["x"].data()->Equals(chunked["y"].data()));
+    }
+
+    SECTION("Select")
+    {
+        std::vector<std::int64_t> index = {5, 0, 3, -1};
+        CHECK(::dataframe::select(chunked, index.begin(), index.end()) ==
+            ::dataframe::select(df, index.begin(), index.end()));
+    }
+
+    SECTION("Sort")
+    {
+        CHECK(::dataframe::sort_index(chunked, "x") ==
+            ::dataframe::sort_index(df, "x"));
+        CHECK(::dataframe::sort(chunked, "y", true) ==
+            ::dataframe::sort(df, "y", true));
+    }
+
+    SECTION("Split")
+    {
+        auto pieces = ::dataframe::split_rows(chunked, 4);
+        CHECK(pieces.size() == 2);
+        CHECK(pieces[0] == df.rows(0, 4));
+        CHECK(pieces[1] == df.rows(4, 6));
+    }
+
+    SECTION("Splice")
+    {
+        ::dataframe::DataFrame sorted;
+        sorted["x"] = std::vector<std::int32_t>{0, 1, 2, 3, 4, 5};
+        auto z = sorted["x"].data();
+
+        ::dataframe::DataFrame spliced(::arrow::Table::Make(
+            sorted.table().schema(),
+            std::vector<std::shared_ptr<::arrow::Column>>{
+                std::make_shared<::arrow::Column>(
+                    sorted.table().schema()->field(0),
+                    make_chunked({z->Slice(0, 2), z->Slice(2, 3),
+                        z->Slice(5)}))}));
+
+        CHECK(::dataframe::splice(spliced, "x", 1, 4) == sorted.rows(1, 4));
+        CHECK(::dataframe::splice(spliced, "x", 3, 9) == sorted.rows(3, 6));
+        CHECK(::dataframe::splice(spliced, "x", 7, 9).nrow() == 0);
+    }
+}
+
+TEST_CASE("Run encoded columns", "[table]")
+{
+    std::int64_t n = 4 * ::dataframe::run_block_size + 10;
+
+    std::vector<std::int32_t> dates;
+    for (std::int64_t i = 0; i != n; ++i) {
+        dates.push_back(static_cast<std::int32_t>(i * 3 / n));
+    }
+
+    ::dataframe::DataFrame df;
+    df["Date"] = dates;
+    df["Source"] = ::dataframe::repeat(std::string("feed"));
+
+    CHECK(df["Source"].nchunks() == 5);
+    CHECK(df["Source"].view<std::string>().back() == "feed");
+
+    auto encoded = ::dataframe::encode_runs(df);
+    CHECK(encoded["Date"].nchunks() > 1);
+    CHECK(encoded == df);
+
+    // Three runs of dates, each sharing one block
+    ::dataframe::DataFrame date;
+    date["Date"] = encoded["Date"];
+    auto report = ::dataframe::memory_report(date);
+    CHECK(static_cast<std::int64_t>(report.unique_bytes) <=
+        3 * 4 * ::dataframe::run_block_size + 256);
+
+    auto sorted = ::dataframe::sort(encoded, "Date", true);
+    CHECK(sorted["Date"].view<std::int32_t>().front() == 2);
+    CHECK(sorted["Source"].view<std::string>().front() == "feed");
+
+    CHECK(::dataframe::encode_runs(df, 2)["Date"].nchunks() == 1);
+    CHECK(::dataframe::encode_runs(df, 64, n)["Date"].nchunks() == 1);
+
+    auto bound = ::dataframe::bind_rows({encoded, encoded});
+    CHECK(bound["Date"].nchunks() == 2 * encoded["Date"].nchunks());
+    CHECK(bound["Source"].nchunks() == 10);
+    CHECK(bound == ::dataframe::bind_rows({df, df}));
+}
@@ -15,6 +15,7 @@
 // ============================================================================
 
 #include <dataframe/table/data_frame.hpp>
+#include <dataframe/table/memory.hpp>
 
 #include <catch2/catch.hpp>
 
@@ -62,3 +63,134 @@ TEST_CASE("Copy on write", "[table]")
         CHECK(other[0].name() == "ID");
     }
 }
+
+TEST_CASE("Construct from columns", "[table]")
+{
+    ::dataframe::DataFrame df({
+        {"ID", ::dataframe::make_array<int>(std::vector<int>{20, 40})},
+        {"Name",
+            ::dataframe::make_array<std::string>(
+                std::vector<std::string>{"John Doe", "Jane Doe"})},
+    });
+
+    CHECK(df.ncol() == 2);
+    CHECK(df.nrow() == 2);
+    CHECK(df.column_index("Name") == 1);
+    CHECK(df.column_index("Age") == -1);
+
+    auto id = df["ID"];
+    df["Name"].remove();
+    df["Age"] = std::vector<int>{30, 50};
+
+    CHECK(df.column_index("Name") == -1);
+    CHECK(df.column_index("Age") == 1);
+    CHECK(df["Age"].view<int>().back() == 50);
+    CHECK(id.view<int>().back() == 40);
+
+    CHECK_THROWS_AS(::dataframe::DataFrame({
+                        {"ID", ::dataframe::make_array<int>(
+                                   std::vector<int>{20, 40})},
+                        {"ID", ::dataframe::make_array<int>(
+                                   std::vector<int>{20, 40})},
+                    }),
+        ::dataframe::DataFrameException);
+}
+
+TEST_CASE("Memory report", "[table]")
+{
+    ::dataframe::DataFrame df;
+    df["ID"] = std::vector<std::int64_t>(1000, 1);
+    df["Name"] = std::vector<std::string>(1000, "abcd");
+
+    // Builders may or may not allocate a validity bitmap without nulls
+    auto full = ::dataframe::memory_report(df);
+    CHECK(full.slice_bytes >= 1000 * 8 + 1001 * 4 + 1000 * 4);
+    CHECK(full.slice_bytes <= 1000 * 8 + 1001 * 4 + 1000 * 4 + 2 * 125);
+    CHECK(full.unique_bytes >= full.slice_bytes);
+    CHECK(full.pools.size() == 1);
+
+    auto first = df.rows(0, 100);
+    auto second = df.rows(100, 1000);
+
+    CHECK(first.memory_usage() >= 100 * 8 + 101 * 4 + 100 * 4);
+    CHECK(first.memory_usage() <= 100 * 8 + 101 * 4 + 100 * 4 + 2 * 13);
+
+    auto split = ::dataframe::memory_report({first, second});
+    CHECK(split.slice_bytes >= full.slice_bytes + 4);
+    CHECK(split.slice_bytes <= full.slice_bytes + 4 + 2);
+    CHECK(split.unique_bytes == full.unique_bytes);
+    CHECK(split.buffer_bytes == 2 * full.buffer_bytes);
+
+    // Dictionary values are counted by all totals
+    ::dataframe::DataFrame dict;
+    dict["Name"] = ::dataframe::make_array<::dataframe::Dict<std::string>>(
+        std::vector<std::string>{"abcd", "efgh", "abcd"});
+    auto report = ::dataframe::memory_report(dict);
+    CHECK(report.buffer_bytes >= report.unique_bytes);
+
+    // Frames are attributed to the arena pools holding their buffers
+    ::dataframe::ArenaMemoryPool arena;
+    {
+        std::vector<std::int64_t> values(1000, 1);
+        ::dataframe::DataFrame scratch;
+        scratch["ID"] = ::dataframe::make_array<std::int64_t>(
+            values.begin(), values.end(), &arena);
+
+        auto pooled = ::dataframe::memory_report(
+            scratch, {&arena, ::arrow::default_memory_pool()});
+        REQUIRE(pooled.pools.size() == 2);
+        CHECK(pooled.pools[0].frame_bytes == pooled.unique_bytes);
+        CHECK(!pooled.pools[1].frame_bytes);
+    }
+    arena.reset();
+}
+
+TEST_CASE("Memory pool", "[table]")
+{
+    ::dataframe::DataFrame df;
+    df["ID"] = std::vector<std::int64_t>{3, 1, 2};
+    df["Name"] = std::vector<std::string>{"c", "a", "b"};
+
+    ::arrow::ProxyMemoryPool pool(::arrow::default_memory_pool());
+
+    auto sorted = ::dataframe::sort(df, "ID", false, &pool);
+    CHECK(pool.bytes_allocated() > 0);
+    CHECK(sorted["Name"].view<std::string>().front() == "a");
+
+    auto bytes = pool.bytes_allocated();
+    auto bound = ::dataframe::bind_rows({df, sorted}, &pool);
+    CHECK(pool.bytes_allocated() > bytes);
+    CHECK(bound.nrow() == 6);
+}
+
+TEST_CASE("Cast cache", "[table]")
+{
+    ::dataframe::DataFrame df;
+    df["ID"] = std::vector<std::int32_t>{1, 2, 3};
+
+    auto v1 = df["ID"].as<double>();
+    auto v2 = df["ID"].as<double>();
+    CHECK(v1.data() == v2.data());
+    CHECK(v2[2] == 3.0);
+
+    // The source itself is not cached
+    CHECK(df["ID"].as<std::int32_t>().data() == df["ID"].data());
+
+    // Casts into another pool are allocated from it and not cached
+    ::arrow::ProxyMemoryPool pool(::arrow::default_memory_pool());
+    auto v3 = df["ID"].as<float>(&pool);
+    CHECK(pool.bytes_allocated() > 0);
+    CHECK(df["ID"].as<float>(&pool).data() != v3.data());
+
+    std::weak_ptr<::arrow::Array> cached = df["ID"].as<float>().data();
+    CHECK(!cached.expired());
+
+    // Reinterpretations share the buffers and are not cached
+    std::weak_ptr<::arrow::Array> shared = df["ID"].as<std::uint32_t>().data();
+    CHECK(shared.expired());
+
+    df["ID"] = std::vector<std::int32_t>{4, 5, 6};
+    CHECK(cached.expired());
+    CHECK(df["ID"].as<double>()[0] == 4.0);
+    CHECK(df["ID"].as<double>().data() != v1.data());
+}
@@ -97,3 +97,29 @@ TEST_CASE("DataFrame Join", "[join]")
                   ::dataframe::JoinType::Anti, true) == ret);
     }
 }
+
+TEST_CASE("DataFrame Join by fixed width keys", "[join]")
+{
+    using Date = ::dataframe::Datestamp<::dataframe::DateUnit::Millisecond>;
+    using Time = ::dataframe::Time<::dataframe::TimeUnit::Nanosecond>;
+
+    ::dataframe::DataFrame df1;
+    df1["Date"] = std::vector<Date>{Date(1), Date(2)};
+    df1["Time"] = std::vector<Time>{Time(1), Time(2)};
+    df1["Key"].emplace<::dataframe::Opaque<int>>(std::vector<int>{1, 2});
+    df1["X"] = std::vector<int>{10, 20};
+
+    ::dataframe::DataFrame df2;
+    df2["Date"] = std::vector<Date>{Date(2), Date(3)};
+    df2["Time"] = std::vector<Time>{Time(2), Time(3)};
+    df2["Key"].emplace<::dataframe::Opaque<int>>(std::vector<int>{2, 3});
+    df2["Y"] = std::vector<int>{30, 40};
+
+    for (auto key : {"Date", "Time", "Key"}) {
+        auto ret = ::dataframe::join(
+            df1, df2, key, ::dataframe::JoinType::Inner, true);
+        CHECK(ret.nrow() == 1);
+        CHECK(ret["X"].view<int>().front() == 20);
+        CHECK(ret["Y"].view<int>().front() == 30);
+    }
+}
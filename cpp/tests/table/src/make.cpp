@@ -0,0 +1,59 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/table/make.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+struct Record {
+    std::int64_t id;
+    double price;
+    std::string symbol;
+    ::dataframe::Timestamp<::dataframe::TimeUnit::Nanosecond> time;
+};
+
+} // namespace
+
+TEST_CASE("Make DataFrame from records", "[table]")
+{
+    std::vector<Record> records;
+    for (std::int64_t i = 0; i != 200000; ++i) {
+        Record r;
+        r.id = i;
+        r.price = static_cast<double>(i) * 0.5;
+        r.symbol = "X" + std::to_string(i % 100);
+        r.time = decltype(r.time)(i * 1000);
+        records.push_back(r);
+    }
+
+    auto df = ::dataframe::make_dataframe(records,
+        DF_FIELD_PAIR(Record, id), DF_FIELD_PAIR(Record, price),
+        DF_FIELD_PAIR(Record, symbol), DF_FIELD_PAIR(Record, time));
+
+    CHECK(df.ncol() == 4);
+    CHECK(df.nrow() == records.size());
+    CHECK(df["id"].view<std::int64_t>().back() == 199999);
+    CHECK(df["symbol"].view<std::string>()[123] == "X23");
+    CHECK(df["time"].is_timestamp());
+
+    auto par = ::dataframe::make_dataframe_parallel(records,
+        DF_FIELD_PAIR(Record, id), DF_FIELD_PAIR(Record, price),
+        DF_FIELD_PAIR(Record, symbol), DF_FIELD_PAIR(Record, time));
+
+    CHECK(par == df);
+}
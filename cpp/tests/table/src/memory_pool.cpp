@@ -0,0 +1,137 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/memory_pool.hpp>
+#include <dataframe/table.hpp>
+
+#include <algorithm>
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <numeric>
+#include <random>
+
+TEST_CASE("ArenaMemoryPool", "[table]")
+{
+    ::dataframe::ArenaMemoryPool pool(1024);
+
+    std::uint8_t *a = nullptr;
+    std::uint8_t *b = nullptr;
+    REQUIRE(pool.Allocate(100, &a).ok());
+    REQUIRE(pool.Allocate(100, &b).ok());
+    CHECK(reinterpret_cast<std::uintptr_t>(a) % 64 == 0);
+    CHECK(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    CHECK(b == a + 128);
+    CHECK(pool.bytes_allocated() == 200);
+
+    // The most recent allocation grows in place
+    REQUIRE(pool.Reallocate(100, 500, &b).ok());
+    CHECK(b == a + 128);
+    CHECK(pool.bytes_allocated() == 600);
+
+    // Allocations larger than a slab get a slab of their own
+    std::uint8_t *c = nullptr;
+    REQUIRE(pool.Allocate(4000, &c).ok());
+    CHECK(pool.capacity() >= 1024 + 4000);
+    CHECK(pool.max_memory() == 4600);
+
+    CHECK_THROWS_AS(pool.reset(), ::dataframe::DataFrameException);
+
+    pool.Free(c, 4000);
+    pool.Free(b, 500);
+    pool.Free(a, 100);
+    CHECK(pool.bytes_allocated() == 0);
+
+    auto capacity = pool.capacity();
+    pool.reset();
+    CHECK(pool.capacity() == capacity);
+
+    std::uint8_t *d = nullptr;
+    REQUIRE(pool.Allocate(100, &d).ok());
+    CHECK(d == a);
+    pool.Free(d, 100);
+}
+
+TEST_CASE("ArenaMemoryPool with table operations", "[table]")
+{
+    ::dataframe::ArenaMemoryPool pool;
+
+    {
+        ::dataframe::DataFrame df;
+        df["ID"] = std::vector<std::int64_t>{3, 1, 2};
+        df["Name"] = std::vector<std::string>{"c", "a", "b"};
+
+        auto sorted = ::dataframe::sort(df, "ID", false, &pool);
+        CHECK(pool.bytes_allocated() > 0);
+        CHECK(sorted["Name"].view<std::string>().front() == "a");
+    }
+
+    CHECK(pool.bytes_allocated() == 0);
+    pool.reset();
+}
+
+TEST_CASE("ArenaMemoryPool benchmark", "[.benchmark]")
+{
+    constexpr int niters = 100;
+    constexpr std::size_t nrows = 100000;
+
+    std::mt19937_64 rng;
+    std::uniform_int_distribution<std::int64_t> rid(0, nrows);
+    std::uniform_real_distribution<double> rval(0, 1);
+
+    std::vector<std::int64_t> keys(nrows);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    std::vector<double> values(nrows);
+    for (auto &v : values) {
+        v = rval(rng);
+    }
+
+    ::dataframe::DataFrame df1;
+    df1["Key"] = keys;
+    df1["Value1"] = values;
+
+    std::shuffle(keys.begin(), keys.end(), rng);
+    ::dataframe::DataFrame df2;
+    df2["Key"] = keys;
+    df2["Value2"] = values;
+
+    auto time = [&](::arrow::MemoryPool *pool, auto &&reset) {
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k != niters; ++k) {
+            {
+                auto sorted = ::dataframe::sort(df1, "Value1", false, pool);
+                auto joined = ::dataframe::join(sorted, df2, "Key",
+                    ::dataframe::JoinType::Inner, false, pool);
+                CHECK(joined.nrow() == nrows);
+            }
+            reset();
+        }
+        auto stop = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(stop - start)
+                   .count() /
+            niters;
+    };
+
+    ::dataframe::ArenaMemoryPool arena(1 << 24, true);
+
+    auto system = time(::arrow::default_memory_pool(), [] {});
+    auto bump = time(&arena, [&] { arena.reset(); });
+
+    WARN("sort + join with default pool: " << system << "ms");
+    WARN("sort + join with arena pool:   " << bump << "ms");
+}
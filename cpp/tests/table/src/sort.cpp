@@ -17,6 +17,7 @@
 #include <dataframe/table/sort.hpp>
 
 #include <catch2/catch.hpp>
+#include <limits>
 
 struct DF {
     ::dataframe::DataFrame orig;
@@ -28,9 +29,13 @@ inline DF make_dataframe()
 {
     using Date = ::dataframe::Datestamp<::dataframe::DateUnit::Day>;
 
+    using Date64 = ::dataframe::Datestamp<::dataframe::DateUnit::Millisecond>;
+
     using Timestamp =
         ::dataframe::Timestamp<::dataframe::TimeUnit::Nanosecond>;
 
+    using Time = ::dataframe::Time<::dataframe::TimeUnit::Millisecond>;
+
     DF ret;
 
     std::vector<std::int8_t> vec = {1, 3, 5, 7, 2, 4, 6, 8};
@@ -57,6 +62,13 @@ inline DF make_dataframe()
         Timestamp(8)  //
     };
 
+    std::vector<Date64> date64;
+    std::vector<Time> time;
+    for (auto v : vec) {
+        date64.emplace_back(v);
+        time.emplace_back(v);
+    }
+
     std::vector<std::string> string = {"1", "3", "5", "7", "2", "4", "6", "8"};
 
     ret.orig["UInt8"] = std::vector<std::uint8_t>(vec.begin(), vec.end());
@@ -71,11 +83,15 @@ inline DF make_dataframe()
     ret.orig["Double"] = std::vector<double>(vec.begin(), vec.end());
     ret.orig["Date"] = date;
     ret.orig["Timestamp"] = timestamp;
+    ret.orig["Date64"] = date64;
+    ret.orig["Time"] = time;
     ret.orig["String"] = string;
 
     std::sort(vec.begin(), vec.end());
     std::sort(date.begin(), date.end());
     std::sort(timestamp.begin(), timestamp.end());
+    std::sort(date64.begin(), date64.end());
+    std::sort(time.begin(), time.end());
     std::sort(string.begin(), string.end());
 
     ret.sorted["UInt8"] = std::vector<std::uint8_t>(vec.begin(), vec.end());
@@ -90,11 +106,15 @@ inline DF make_dataframe()
     ret.sorted["Double"] = std::vector<double>(vec.begin(), vec.end());
     ret.sorted["Date"] = date;
     ret.sorted["Timestamp"] = timestamp;
+    ret.sorted["Date64"] = date64;
+    ret.sorted["Time"] = time;
     ret.sorted["String"] = string;
 
     std::reverse(vec.begin(), vec.end());
     std::reverse(date.begin(), date.end());
     std::reverse(timestamp.begin(), timestamp.end());
+    std::reverse(date64.begin(), date64.end());
+    std::reverse(time.begin(), time.end());
     std::reverse(string.begin(), string.end());
 
     ret.rsorted["UInt8"] = std::vector<std::uint8_t>(vec.begin(), vec.end());
@@ -109,6 +129,8 @@ inline DF make_dataframe()
     ret.rsorted["Double"] = std::vector<double>(vec.begin(), vec.end());
     ret.rsorted["Date"] = date;
     ret.rsorted["Timestamp"] = timestamp;
+    ret.rsorted["Date64"] = date64;
+    ret.rsorted["Time"] = time;
     ret.rsorted["String"] = string;
 
     return ret;
@@ -136,4 +158,30 @@ DEFINE_TEST_CASE(Float)
 DEFINE_TEST_CASE(Double)
 DEFINE_TEST_CASE(Date)
 DEFINE_TEST_CASE(Timestamp)
+DEFINE_TEST_CASE(Date64)
+DEFINE_TEST_CASE(Time)
 DEFINE_TEST_CASE(String)
+
+TEST_CASE("Sort DataFrame with NaN", "[sort]")
+{
+    auto nan = std::numeric_limits<double>::quiet_NaN();
+
+    ::dataframe::DataFrame df;
+    df["x"] = std::vector<double>{1.0, nan, 0.0};
+    df["y"] = std::vector<int>{1, 2, 3};
+
+    // The statistics do not claim that the column is sorted
+    auto stats = df["x"].stats();
+    CHECK(!stats->sorted);
+    CHECK(stats->nan_count == 1);
+
+    auto sorted = ::dataframe::sort(df, "x");
+    CHECK(sorted["y"].view<int>() ==
+        ::dataframe::make_view<int>(
+            ::dataframe::make_array<int>(std::vector<int>{3, 1, 2})));
+
+    auto rsorted = ::dataframe::sort(df, "x", true);
+    CHECK(rsorted["y"].view<int>() ==
+        ::dataframe::make_view<int>(
+            ::dataframe::make_array<int>(std::vector<int>{1, 3, 2})));
+}
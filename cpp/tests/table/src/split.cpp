@@ -0,0 +1,122 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/table/split.hpp>
+
+#include <catch2/catch.hpp>
+#include <map>
+
+inline std::vector<std::int32_t> split_values(
+    const ::dataframe::DataFrame &df)
+{
+    auto view = df["value"].view<std::int32_t>();
+
+    return std::vector<std::int32_t>(view.begin(), view.end());
+}
+
+TEST_CASE("Split by key", "[table]")
+{
+    ::dataframe::DataFrame df;
+    df["key"] = std::vector<std::string>{"b", "a", "b", "c", "a", "b"};
+    df["value"] = std::vector<std::int32_t>{0, 1, 2, 3, 4, 5};
+
+    auto groups = ::dataframe::split_by(df, "key");
+
+    REQUIRE(groups.size() == 3);
+    CHECK(split_values(groups[0]) == std::vector<std::int32_t>{0, 2, 5});
+    CHECK(split_values(groups[1]) == std::vector<std::int32_t>{1, 4});
+    CHECK(split_values(groups[2]) == std::vector<std::int32_t>{3});
+    CHECK(groups[2]["key"].view<std::string>().front() == "c");
+
+    // Fixed size binary keys
+    ::dataframe::DataFrame opaque;
+    opaque["key"].emplace<::dataframe::Opaque<int>>(
+        std::vector<int>{2, 1, 2, 3, 1, 2});
+    opaque["value"] = std::vector<std::int32_t>{0, 1, 2, 3, 4, 5};
+
+    auto opaque_groups = ::dataframe::split_by(opaque, "key");
+
+    REQUIRE(opaque_groups.size() == 3);
+    CHECK(split_values(opaque_groups[0]) ==
+        std::vector<std::int32_t>{0, 2, 5});
+    CHECK(split_values(opaque_groups[1]) == std::vector<std::int32_t>{1, 4});
+    CHECK(split_values(opaque_groups[2]) == std::vector<std::int32_t>{3});
+}
+
+TEST_CASE("Partition by key", "[table]")
+{
+    std::vector<std::int64_t> key;
+    std::vector<std::int64_t> value;
+    for (std::int64_t i = 0; i != 1000; ++i) {
+        key.push_back(i % 37);
+        value.push_back(i);
+    }
+
+    ::dataframe::DataFrame df;
+    df["key"] = key;
+    df["value"] = value;
+
+    auto parts = ::dataframe::partition(df, "key", 4);
+    REQUIRE(parts.size() == 4);
+
+    std::size_t nrow = 0;
+    std::map<std::int64_t, std::size_t> owner;
+    for (std::size_t k = 0; k != parts.size(); ++k) {
+        nrow += parts[k].nrow();
+
+        auto keys = parts[k]["key"].view<std::int64_t>();
+        auto values = parts[k]["value"].view<std::int64_t>();
+        CHECK(std::is_sorted(values.begin(), values.end()));
+
+        for (auto v : keys) {
+            CHECK(owner.emplace(v, k).first->second == k);
+        }
+    }
+
+    CHECK(nrow == df.nrow());
+    CHECK(owner.size() == 37);
+}
+
+TEST_CASE("Split by bytes", "[table]")
+{
+    std::vector<std::int64_t> value;
+    std::vector<std::string> text;
+    for (std::int64_t i = 0; i != 1000; ++i) {
+        value.push_back(i);
+        text.push_back(std::string(static_cast<std::size_t>(i % 100), 'x'));
+    }
+
+    ::dataframe::DataFrame df;
+    df["value"] = value;
+    df["text"] = text;
+
+    auto pieces = ::dataframe::split_bytes(df, 4096);
+    CHECK(pieces.size() > 1);
+
+    std::size_t nrow = 0;
+    for (std::size_t k = 0; k != pieces.size(); ++k) {
+        nrow += pieces[k].nrow();
+
+        // slices share the buffers of the original columns
+        CHECK(pieces[k]["text"].data()->data()->buffers[2] ==
+            df["text"].data()->data()->buffers[2]);
+    }
+    CHECK(nrow == df.nrow());
+
+    auto merged = ::dataframe::coalesce(pieces, 1 << 20);
+    REQUIRE(merged.size() == 1);
+    CHECK(merged.front() == df);
+}
@@ -0,0 +1,72 @@
+// ============================================================================
+// Copyright 2019 Fairtide Pte. Ltd.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ============================================================================
+
+#include <dataframe/table/typed_frame.hpp>
+
+#include <catch2/catch.hpp>
+
+namespace {
+
+constexpr char px[] = "px";
+constexpr char qty[] = "qty";
+
+struct Trade {
+    double px;
+    std::int64_t qty;
+};
+
+using Trades = ::dataframe::TypedFrame<::dataframe::Column<px, double>,
+    ::dataframe::Column<qty, std::int64_t>>;
+
+} // namespace
+
+TEST_CASE("TypedFrame", "[typed_frame]")
+{
+    ::dataframe::DataFrame df;
+    df["px"] = std::vector<double>{1.5, 2.5, 3.5};
+    df["qty"] = std::vector<std::int32_t>{10, 20, 30};
+
+    Trades trades(df);
+    CHECK(trades.size() == 3);
+    CHECK(Trades::index_of<qty>() == 1);
+    CHECK(trades[1].get<px>() == 2.5);
+    CHECK(trades.back().get<qty>() == 30);
+    CHECK(!trades.front().is_null<px>());
+    CHECK_THROWS_AS(trades.at(3), std::out_of_range);
+
+    double notional = 0;
+    for (auto row : trades) {
+        notional += row.get<px>() * static_cast<double>(row.get<qty>());
+    }
+    CHECK(notional == Approx(1.5 * 10 + 2.5 * 20 + 3.5 * 30));
+
+    auto records = trades.to_records<Trade>();
+    REQUIRE(records.size() == 3);
+    CHECK(records[2].px == 3.5);
+    CHECK(records[2].qty == 30);
+
+    auto ret = Trades::from_records(records, &Trade::px, &Trade::qty);
+    CHECK(ret.data()["px"].view<double>() == df["px"].view<double>());
+    CHECK(ret.data()["qty"].is_type<std::int64_t>());
+
+    std::vector<std::tuple<double, std::int64_t>> tuples = {{4.5, 40}};
+    auto tup = Trades::from_records(tuples.begin(), tuples.end());
+    CHECK(tup.size() == 1);
+    CHECK(tup.column<qty>().front() == 40);
+
+    df["px"].remove();
+    CHECK_THROWS_AS(Trades(df), ::dataframe::DataFrameException);
+}